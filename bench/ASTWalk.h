@@ -0,0 +1,75 @@
+#pragma once
+// ============================================================
+//  Child traversal for the benchmarks
+//
+//  forEachChild(n, f) calls f(child) for every direct child node of
+//  n, in source order (the order CodeGen visits them).
+// ============================================================
+
+#include "parser/AST.h"
+
+template <typename F>
+void forEachChild(const AST* n, F&& f) {
+    auto each = [&](const ArenaList<AST*>& list) { for (const AST* c : list) f(c); };
+    auto one  = [&](const AST* c) { if (c) f(c); };
+
+    switch (n->kind) {
+    case ASTKind::Program:      each(static_cast<const ProgramAST*>(n)->topLevel); break;
+    case ASTKind::Block:        each(static_cast<const BlockAST*>(n)->statements); break;
+    case ASTKind::Call:         each(static_cast<const CallAST*>(n)->args); break;
+    case ASTKind::MethodCall:   each(static_cast<const MethodCallAST*>(n)->args); break;
+    case ASTKind::ClassDecl:
+        for (const FunctionAST* m : static_cast<const ClassDeclAST*>(n)->methods) f(m);
+        break;
+    case ASTKind::Function: {
+        auto* fn = static_cast<const FunctionAST*>(n);
+        one(fn->proto); one(fn->body);
+        break;
+    }
+    case ASTKind::Binary: {
+        auto* b = static_cast<const BinaryAST*>(n);
+        one(b->lhs); one(b->rhs);
+        break;
+    }
+    case ASTKind::Logical: {
+        auto* l = static_cast<const LogicalAST*>(n);
+        one(l->lhs); one(l->rhs);
+        break;
+    }
+    case ASTKind::Unary:        one(static_cast<const UnaryAST*>(n)->operand); break;
+    case ASTKind::Return:       one(static_cast<const ReturnAST*>(n)->expr); break;
+    case ASTKind::Assign:       one(static_cast<const AssignAST*>(n)->expr); break;
+    case ASTKind::VarDeclInit:  one(static_cast<const VarDeclInitAST*>(n)->init); break;
+    case ASTKind::MemberAssign: one(static_cast<const MemberAssignAST*>(n)->expr); break;
+    case ASTKind::ThisAssign:   one(static_cast<const ThisAssignAST*>(n)->expr); break;
+    case ASTKind::ArrayAccess:  one(static_cast<const ArrayAccessAST*>(n)->index); break;
+    case ASTKind::ArrayAssign: {
+        auto* a = static_cast<const ArrayAssignAST*>(n);
+        one(a->index); one(a->expr);
+        break;
+    }
+    case ASTKind::If: {
+        auto* i = static_cast<const IfAST*>(n);
+        one(i->cond); one(i->thenBlock); one(i->elseBlock);
+        break;
+    }
+    case ASTKind::While: {
+        auto* w = static_cast<const WhileAST*>(n);
+        one(w->cond); one(w->body);
+        break;
+    }
+    case ASTKind::For: {
+        auto* fo = static_cast<const ForAST*>(n);
+        one(fo->init); one(fo->cond); one(fo->body); one(fo->inc);
+        break;
+    }
+    default:
+        break;   // leaves
+    }
+}
+
+inline size_t countNodes(const AST* n) {
+    size_t c = 1;
+    forEachChild(n, [&](const AST* child) { c += countNodes(child); });
+    return c;
+}
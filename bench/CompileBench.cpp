@@ -0,0 +1,267 @@
+// ============================================================
+//  End-to-end compile throughput benchmark
+//
+//  Generates a large synthetic program (bench/ProgramGen.h) and
+//  runs it through Lexer → TokenStream → Parser → Resolver → Checker →
+//  CodeGen → optimize() at every OptLevel, reporting per phase:
+//
+//   tokens/s, AST nodes/s, IR instructions/s, AST teardown time
+//   and peak RSS.
+//
+//  Each level is then compiled again in lean mode (--release: no
+//  comments, value names, symbol log or per-function verification)
+//  and the speedup over the full compile reported, along with the cost
+//  of --check (everything up to the checker, no LLVMContext).
+//
+//  The parser is also timed serially and with one thread per core
+//  (top-level items parsed concurrently); both must build the same
+//  number of nodes.
+//
+//  A scaling run then compiles the program at 1x, 2x and 4x its
+//  size; time per token should stay flat, so any phase whose
+//  per-token cost grows by more than 1.5x is flagged as
+//  superlinear.
+//
+//  Usage:  ./bench_compile [functions=100] [classes=10] [seed=1] [rounds=3] [dump.mc]
+// ============================================================
+
+#include "ASTWalk.h"
+#include "ProgramGen.h"
+#include "codegen/CodeGen.h"
+#include "lexer/Lexer.h"
+#include "lexer/TokenStream.h"
+#include "parser/Parser.h"
+#include "semantic/Checker.h"
+#include "semantic/Resolver.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// ── Peak RSS ──────────────────────────────────────────────────
+// VmHWM from /proc/self/status; writing 5 to clear_refs resets it so
+// each level reports its own high-water mark (Linux only, 0 elsewhere).
+static void resetPeakRss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+static long peakRssKb() {
+    std::ifstream in("/proc/self/status");
+    std::string key;
+    while (in >> key) {
+        if (key == "VmHWM:") { long kb = 0; in >> kb; return kb; }
+        in.ignore(1 << 10, '\n');
+    }
+    return 0;
+}
+
+// ── IR size ───────────────────────────────────────────────────
+static size_t countInstructions(const llvm::Module& m) {
+    size_t n = 0;
+    for (auto& fn : m) n += fn.getInstructionCount();
+    return n;
+}
+
+// ── One compile ───────────────────────────────────────────────
+struct Sample {
+    double lex = 0, parse = 0, resolve = 0, check = 0, codegen = 0, opt = 0, teardown = 0;
+    size_t tokens = 0, nodes = 0, instrs = 0, instrsOpt = 0;
+    long   rssKb = 0;
+    bool   ok = true;
+
+    double total() const { return lex + parse + resolve + check + codegen + opt; }
+    void keepBest(const Sample& s) {
+        if (lex == 0 || s.lex < lex)         lex = s.lex;
+        if (parse == 0 || s.parse < parse)   parse = s.parse;
+        if (resolve == 0 || s.resolve < resolve) resolve = s.resolve;
+        if (check == 0 || s.check < check)   check = s.check;
+        if (codegen == 0 || s.codegen < codegen) codegen = s.codegen;
+        if (opt == 0 || s.opt < opt)         opt = s.opt;
+        if (teardown == 0 || s.teardown < teardown) teardown = s.teardown;
+        tokens = s.tokens; nodes = s.nodes; instrs = s.instrs; instrsOpt = s.instrsOpt;
+        rssKb = std::max(rssKb, s.rssKb);
+        ok = ok && s.ok;
+    }
+};
+
+static Sample compile(const std::string& src, OptLevel level, bool lean = false) {
+    Sample s;
+    resetPeakRss();
+
+    auto t0 = Clock::now();
+    AtomTable        atoms;          // per compile, as in the driver
+    AtomTable::Scope interning(atoms);
+    Lexer lexer(src, !lean);
+    TokenStream tokens(lexer);
+    auto t1 = Clock::now();
+    Parser parser(tokens);
+    auto ast = parser.parse();
+    auto t2 = Clock::now();
+    Resolver().resolve(*ast);
+    auto tr = Clock::now();
+    Checker checker;
+    checker.check(*ast);
+    auto tc = Clock::now();
+    CodeGenOptions opts;
+    opts.lean = lean;
+    CodeGen cg(opts);
+    cg.generate(ast.get());
+    auto t3 = Clock::now();
+    s.instrs = countInstructions(cg.getModule());
+    auto t4 = Clock::now();
+    cg.optimize(level);
+    auto t5 = Clock::now();
+
+    s.lex = seconds(t0, t1);  s.parse = seconds(t1, t2);  s.resolve = seconds(t2, tr);
+    s.check = seconds(tr, tc);  s.codegen = seconds(tc, t3);  s.opt = seconds(t4, t5);
+    s.tokens    = tokens.size();
+    s.nodes     = countNodes(ast.get());
+    s.instrsOpt = countInstructions(cg.getModule());
+    s.rssKb     = peakRssKb();
+
+    auto report = [&](const char* phase, const std::string& msg) {
+        if (s.ok) std::cerr << phase << " error in generated program: " << msg << "\n";
+        s.ok = false;
+    };
+    for (auto& e : lexer.getErrors())  report("lex", e.message);
+    for (auto& e : parser.getErrors()) report("parse", e.message);
+    for (auto& e : checker.getErrors()) report("check", e.message);
+    for (auto& e : cg.getErrors())     report("codegen", e.message);
+
+    auto t6 = Clock::now();
+    ast.reset();
+    s.teardown = seconds(t6, Clock::now());
+    return s;
+}
+
+static Sample best(const std::string& src, OptLevel level, int rounds, bool lean = false) {
+    Sample b;
+    for (int r = 0; r < rounds; ++r) b.keepBest(compile(src, level, lean));
+    return b;
+}
+
+static std::string rate(double n, double sec) {
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(2);
+    double r = sec > 0 ? n / sec : 0;
+    if (r >= 1e6) os << r / 1e6 << " M/s";
+    else          os << r / 1e3 << " K/s";
+    return os.str();
+}
+
+int main(int argc, char* argv[]) {
+    GenOptions opt;
+    opt.functions = argc > 1 ? std::atoi(argv[1]) : 100;
+    opt.classes   = argc > 2 ? std::atoi(argv[2]) : 10;
+    opt.seed      = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+    int rounds    = argc > 4 ? std::atoi(argv[4]) : 3;
+
+    std::string src = ProgramGen(opt).generate();
+    if (argc > 5) std::ofstream(argv[5]) << src;
+
+    const char* names[] = { "O0", "O1", "O2", "O3" };
+    const OptLevel levels[] = { OptLevel::O0, OptLevel::O1, OptLevel::O2, OptLevel::O3 };
+
+    std::cout << "program: " << opt.functions << " functions, " << opt.classes
+              << " classes, seed " << opt.seed << ", " << (src.size() >> 10)
+              << " KiB  rounds: " << rounds << "\n";
+
+    bool ok = true;
+    double full[4] = {}, front = 0;
+    for (int i = 0; i < 4; ++i) {
+        Sample s = best(src, levels[i], rounds);
+        full[i] = s.total();
+        if (i == 0) front = s.lex + s.parse + s.resolve + s.check;
+        ok = ok && s.ok;
+        if (i == 0)
+            std::cout << "  " << s.tokens << " tokens, " << s.nodes << " AST nodes, "
+                      << s.instrs << " IR instructions\n";
+        std::cout << std::fixed << std::setprecision(1)
+                  << names[i] << ": total " << s.total() * 1e3 << " ms"
+                  << "  lex " << s.lex * 1e3 << " ms (" << rate((double)s.tokens, s.lex) << " tokens)"
+                  << "  parse " << s.parse * 1e3 << " ms (" << rate((double)s.nodes, s.parse) << " nodes)"
+                  << "  resolve " << s.resolve * 1e3 << " ms"
+                  << "  check " << s.check * 1e3 << " ms"
+                  << "  codegen " << s.codegen * 1e3 << " ms (" << rate((double)s.instrs, s.codegen) << " instrs)";
+        if (levels[i] != OptLevel::O0)
+            std::cout << "  opt " << s.opt * 1e3 << " ms (" << rate((double)s.instrs, s.opt)
+                      << " instrs, " << s.instrs << " -> " << s.instrsOpt << ")";
+        std::cout << "  AST free " << s.teardown * 1e3 << " ms"
+                  << "  peak RSS " << s.rssKb / 1024.0 << " MiB\n";
+    }
+
+    // ── Lean (--release) ──────────────────────────────────────
+    std::cout << "release:";
+    for (int i = 0; i < 4; ++i) {
+        Sample s = best(src, levels[i], rounds, true);
+        ok = ok && s.ok;
+        std::cout << std::fixed << std::setprecision(1) << "  " << names[i] << " "
+                  << s.total() * 1e3 << " ms (codegen " << s.codegen * 1e3 << " ms, "
+                  << std::setprecision(2) << full[i] / s.total() << "x)";
+    }
+    std::cout << "\n";
+
+    // ── --check ───────────────────────────────────────────────
+    std::cout << std::fixed << std::setprecision(1) << "check: " << front * 1e3
+              << " ms (" << std::setprecision(2) << full[0] / front << "x faster than O0)\n";
+
+    // ── Parallel parse ────────────────────────────────────────
+    {
+        unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+        Lexer lexer(src, true);
+        TokenStream tokens(lexer);
+        double sec[2]   = {};
+        size_t nodes[2] = {};
+        for (int m = 0; m < 2; ++m)
+            for (int r = 0; r < rounds; ++r) {
+                Parser parser(tokens, m ? threads : 1);
+                auto t0 = Clock::now();
+                auto ast = parser.parse();
+                double t = seconds(t0, Clock::now());
+                if (r == 0 || t < sec[m]) sec[m] = t;
+                nodes[m] = countNodes(ast.get());
+                ok = ok && !parser.hasErrors();
+            }
+        if (nodes[0] != nodes[1]) {
+            std::cerr << "parallel parse built " << nodes[1] << " nodes, serial " << nodes[0] << "\n";
+            ok = false;
+        }
+        std::cout << std::fixed << std::setprecision(1)
+                  << "parse: serial " << sec[0] * 1e3 << " ms  " << threads << " threads "
+                  << sec[1] * 1e3 << " ms (" << std::setprecision(2) << sec[0] / sec[1] << "x)\n";
+    }
+
+    // ── Scaling ───────────────────────────────────────────────
+    // Per-token cost of each phase at O2 for 1x, 2x and 4x the program.
+    std::cout << "scaling (O2, ns per token):\n";
+    double base[6] = {};
+    for (int k : {1, 2, 4}) {
+        GenOptions o = opt;
+        o.functions *= k;
+        o.classes   *= k;
+        std::string text = ProgramGen(o).generate();
+        Sample s = best(text, OptLevel::O2, rounds);
+        ok = ok && s.ok;
+        double per[6] = { s.lex, s.parse, s.resolve, s.check, s.codegen, s.opt };
+        const char* phase[6] = { "lex", "parse", "resolve", "check", "codegen", "opt" };
+        std::cout << "  " << k << "x:";
+        for (int p = 0; p < 6; ++p) {
+            per[p] = per[p] * 1e9 / (double)s.tokens;
+            if (k == 1) base[p] = per[p];
+            std::cout << "  " << phase[p] << " " << std::setprecision(2) << per[p];
+            if (k > 1 && base[p] > 0 && per[p] > 1.5 * base[p]) std::cout << " (superlinear?)";
+        }
+        std::cout << "\n";
+    }
+    return ok ? 0 : 1;
+}
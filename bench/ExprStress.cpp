@@ -0,0 +1,179 @@
+// ============================================================
+//  Expression parser stress test
+//
+//  Feeds the parser single expressions of up to [terms] terms in
+//  three shapes:
+//
+//   flat    a + 3 * b < a - 2 && ...   long operator chain, mixed
+//                                      precedences and unary ops
+//   parens  -(-(-( ... (a + 1) ... )))  one paren and one unary per term
+//   right   a + (b * (a - (b + ...)))   right-nested through parens
+//
+//  Every parse runs on a thread with a 256 KiB stack, so a parser
+//  that recursed per term or per parenthesis would crash here.  Each
+//  result is checked for errors and for the expected node count, and
+//  parse time per term is reported at 1/4, 1/2 and full size.  Deep
+//  shapes drift up a little as the frame stack outgrows the caches; a
+//  shape whose per-term cost more than doubles over the 4x size range
+//  (a quadratic parser would quadruple) is flagged.
+//
+//  Usage:  ./bench_expr [terms=100000] [rounds=3] [seed=1]
+// ============================================================
+
+#include "ASTWalk.h"
+#include "lexer/Lexer.h"
+#include "lexer/TokenStream.h"
+#include "parser/Parser.h"
+#include <pthread.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ── Sources ───────────────────────────────────────────────────
+// Each builder returns the expression and the node count it must
+// parse to.
+
+struct Expr {
+    std::string text;
+    size_t      nodes = 0;
+};
+
+static const char* kBinOps[] = { "+", "-", "*", "/", "<", ">", "<=", ">=", "==", "!=", "&&", "||" };
+
+static Expr flat(int terms, uint64_t seed) {
+    Expr e;
+    uint64_t s = seed;
+    auto next = [&] { s = s * 6364136223846793005ULL + 1442695040888963407ULL; return (uint32_t)(s >> 33); };
+    for (int i = 0; i < terms; ++i) {
+        if (i) { e.text += ' '; e.text += kBinOps[next() % 12]; e.text += ' '; ++e.nodes; }
+        if (next() % 8 == 0) { e.text += next() % 2 ? "-" : "!"; ++e.nodes; }
+        switch (next() % 3) {
+            case 0:  e.text += 'a'; break;
+            case 1:  e.text += 'b'; break;
+            default: e.text += std::to_string(next() % 100); break;
+        }
+        ++e.nodes;
+    }
+    return e;
+}
+
+static Expr parens(int terms) {
+    Expr e;
+    for (int i = 0; i < terms; ++i) e.text += "-(";
+    e.text += "a + 1";
+    e.text.append((size_t)terms, ')');
+    e.nodes = (size_t)terms + 3;
+    return e;
+}
+
+static Expr right(int terms) {
+    Expr e;
+    for (int i = 1; i < terms; ++i) {
+        e.text += i % 2 ? "a " : "b ";
+        e.text += kBinOps[i % 4];
+        e.text += " (";
+    }
+    e.text += 'a';
+    e.text.append((size_t)(terms - 1), ')');
+    e.nodes = 2 * (size_t)terms - 1;
+    return e;
+}
+
+// ── Parse on a small stack ────────────────────────────────────
+
+struct Job {
+    const std::string* src;
+    double             seconds = 0;
+    size_t             nodes   = 0;
+    size_t             errors  = 0;
+};
+
+// Counts with an explicit stack: the trees are as deep as they are long.
+static size_t countIter(const AST* root) {
+    size_t n = 0;
+    std::vector<const AST*> todo{root};
+    while (!todo.empty()) {
+        const AST* a = todo.back();
+        todo.pop_back();
+        ++n;
+        forEachChild(a, [&](const AST* c) { todo.push_back(c); });
+    }
+    return n;
+}
+
+static void* runJob(void* p) {
+    auto* job = static_cast<Job*>(p);
+    Lexer lexer(*job->src, false);
+    TokenStream tokens(lexer);
+    Parser parser(tokens);
+    auto t0 = std::chrono::steady_clock::now();
+    auto ast = parser.parse();
+    job->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    job->errors = lexer.getErrors().size() + parser.getErrors().size();
+    job->nodes  = countIter(ast.get());
+    return nullptr;
+}
+
+static Job parseOnSmallStack(const std::string& src) {
+    Job job;
+    job.src = &src;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    pthread_t th;
+    if (pthread_create(&th, &attr, runJob, &job) != 0) runJob(&job);
+    else pthread_join(th, nullptr);
+    pthread_attr_destroy(&attr);
+    return job;
+}
+
+int main(int argc, char* argv[]) {
+    int      terms  = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int      rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+    uint64_t seed   = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+    if (terms < 4) terms = 4;
+
+    // Program wrapper: ProgramAST, FunctionDefinition, Prototype, Block,
+    // two VarDecls and the ReturnStmt around the expression.
+    const size_t wrapperNodes = 7;
+    auto wrap = [](const std::string& e) {
+        return "int main() { int a; int b; return " + e + "; }\n";
+    };
+
+    std::cout << "expression parser stress: up to " << terms << " terms, rounds: " << rounds
+              << ", 256 KiB parser stack\n";
+
+    bool ok = true;
+    const char* names[] = { "flat", "parens", "right" };
+    for (int shape = 0; shape < 3; ++shape) {
+        double base = 0;
+        std::cout << "  " << std::left << std::setw(7) << names[shape] << std::right;
+        for (int k : {4, 2, 1}) {
+            int n = terms / k;
+            Expr e = shape == 0 ? flat(n, seed) : shape == 1 ? parens(n) : right(n);
+            std::string src = wrap(e.text);
+
+            double best = 0;
+            for (int r = 0; r < rounds; ++r) {
+                Job job = parseOnSmallStack(src);
+                if (job.errors || job.nodes != e.nodes + wrapperNodes) {
+                    std::cerr << names[shape] << " x" << n << ": " << job.errors << " errors, "
+                              << job.nodes << " nodes (expected " << e.nodes + wrapperNodes << ")\n";
+                    ok = false;
+                }
+                if (r == 0 || job.seconds < best) best = job.seconds;
+            }
+            double perTerm = best * 1e9 / n;
+            if (k == 4) base = perTerm;
+            std::cout << std::fixed << std::setprecision(1) << "  " << n << ": "
+                      << best * 1e3 << " ms (" << std::setprecision(2) << perTerm << " ns/term)";
+            if (k == 1 && base > 0 && perTerm > 2 * base) std::cout << " (superlinear?)";
+        }
+        std::cout << "\n";
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// ============================================================
+//  Keyword recognition micro-benchmark
+//
+//  Compares the perfect-hash lookupKeyword() used by the lexer
+//  against the original 15-way if/else string compare chain on an
+//  identifier-heavy word stream (about 1 keyword per 10 words,
+//  roughly what real .mc sources look like).
+//
+//  Usage:  ./bench_keywords [words=1000000] [rounds=20]
+// ============================================================
+
+#include "lexer/Keywords.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The lexer's keyword classification before the perfect hash.
+static TokenType chainLookup(std::string_view id) {
+    if      (id == "int")      return TokenType::INT;
+    else if (id == "float")    return TokenType::FLOAT;
+    else if (id == "void")     return TokenType::VOID;
+    else if (id == "return")   return TokenType::RETURN;
+    else if (id == "if")       return TokenType::IF;
+    else if (id == "else")     return TokenType::ELSE;
+    else if (id == "while")    return TokenType::WHILE;
+    else if (id == "for")      return TokenType::FOR;
+    else if (id == "break")    return TokenType::BREAK;
+    else if (id == "continue") return TokenType::CONTINUE;
+    else if (id == "class")    return TokenType::CLASS;
+    else if (id == "new")      return TokenType::NEW;
+    else if (id == "this")     return TokenType::THIS;
+    else if (id == "public")   return TokenType::PUBLIC;
+    else if (id == "private")  return TokenType::PRIVATE;
+    return TokenType::IDENT;
+}
+
+// Deterministic identifier generator (fixed-seed LCG).
+static std::vector<std::string> makeWords(size_t n) {
+    static const char* stems[] = {
+        "i", "j", "n", "sum", "count", "value", "index", "tmp", "result",
+        "acc", "left", "right", "node", "total", "getX", "setY", "p", "obj"
+    };
+    const size_t nStems = sizeof(stems) / sizeof(stems[0]);
+    const size_t nKw    = sizeof(kKeywords) / sizeof(kKeywords[0]);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&]() { state = state * 6364136223846793005ull + 1442695040888963407ull;
+                        return (uint32_t)(state >> 33); };
+    std::vector<std::string> words;
+    words.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t r = next();
+        if (r % 10 == 0) {
+            words.emplace_back(kKeywords[next() % nKw].spelling);
+        } else {
+            std::string w = stems[next() % nStems];
+            if (r % 3 == 0) w += std::to_string(next() % 100);
+            words.push_back(std::move(w));
+        }
+    }
+    return words;
+}
+
+template <typename Fn>
+static double timeIt(const std::vector<std::string_view>& words, int rounds,
+                     Fn fn, uint64_t& checksum)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (auto w : words) checksum += (uint64_t)fn(w);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count()
+           / ((double)words.size() * rounds);
+}
+
+int main(int argc, char* argv[]) {
+    size_t nWords = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int    rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    auto storage = makeWords(nWords);
+    std::vector<std::string_view> words(storage.begin(), storage.end());
+
+    for (auto w : words)
+        if (chainLookup(w) != lookupKeyword(w)) {
+            std::cerr << "MISMATCH on '" << w << "'\n";
+            return 1;
+        }
+
+    uint64_t sumChain = 0, sumHash = 0;
+    double chainNs = timeIt(words, rounds, chainLookup, sumChain);
+    double hashNs  = timeIt(words, rounds, lookupKeyword, sumHash);
+    if (sumChain != sumHash) { std::cerr << "checksum mismatch\n"; return 1; }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "words: " << nWords << "  rounds: " << rounds << "\n"
+              << "  if/else chain : " << chainNs << " ns/lookup\n"
+              << "  perfect hash  : " << hashNs  << " ns/lookup\n"
+              << "  speedup       : " << chainNs / hashNs << "x\n";
+    return 0;
+}
@@ -0,0 +1,355 @@
+#pragma once
+// ============================================================
+//  Deterministic .mc program generator
+//
+//  Produces large, valid (error-free) Quail programs for the
+//  benchmarks: N free functions, M classes with fields and
+//  methods, nested if/while/for blocks, arrays, objects, long
+//  mixed int/float expressions and big comment blocks.  The same
+//  GenOptions (including the seed) always yield the same text.
+// ============================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GenOptions {
+    uint64_t seed         = 1;
+    int      functions    = 100;   // free functions, plus main()
+    int      classes      = 10;    // interleaved with the functions
+    int      statements   = 12;    // statements in a function's outer block
+    int      depth        = 4;     // maximum block nesting
+    int      exprTerms    = 12;    // leaves in a full-size expression
+    int      commentLines = 6;     // lines per block comment
+};
+
+class ProgramGen {
+public:
+    explicit ProgramGen(const GenOptions& o)
+        : opt(o), state(o.seed * 0x9E3779B97F4A7C15ull + 0xD1B54A32D192ED03ull) {}
+
+    std::string generate() {
+        out.clear();
+        comment(0);
+        int classEvery = opt.classes > 0 ? std::max(1, opt.functions / opt.classes) : 0;
+        for (int i = 0; i < opt.functions; ++i) {
+            if (classEvery && i % classEvery == 0 && (int)classes.size() < opt.classes)
+                classDecl();
+            function();
+        }
+        while ((int)classes.size() < opt.classes) classDecl();
+        mainFunction();
+        return out;
+    }
+
+private:
+    struct Var {
+        std::string name;
+        int         cls     = -1;   // >= 0: object of classes[cls]
+        int         arrSize = 0;    // > 0: array
+    };
+    struct Fn  { std::string name; int arity; };
+    struct Cls { std::string name; int fields; };
+
+    GenOptions                    opt;
+    uint64_t                      state;
+    std::string                   out;
+    std::vector<Fn>               fns;
+    std::vector<Cls>              classes;
+    std::vector<std::vector<Var>> scopes;
+    int                           counter     = 0;
+    int                           indent      = 0;
+    int                           classFields = 0;   // > 0 while generating a method
+
+    // ── Randomness ────────────────────────────────────────────
+    uint32_t next() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return (uint32_t)(state >> 33);
+    }
+    int  pick(int n)         { return n > 0 ? (int)(next() % (uint32_t)n) : 0; }
+    bool chance(int percent) { return pick(100) < percent; }
+
+    // ── Output helpers ────────────────────────────────────────
+    void line(const std::string& s) {
+        out.append(indent * 4, ' ');
+        out += s;
+        out += '\n';
+    }
+    std::string fresh(const char* prefix) { return prefix + std::to_string(counter++); }
+
+    void comment(int words) {
+        static const char* lorem[] = {
+            "compute", "the", "running", "total", "for", "each", "element", "and",
+            "keep", "track", "of", "state", "across", "iterations", "so", "that",
+            "invariant", "holds", "until", "loop", "exits", "cleanly", "overflow", "is",
+        };
+        const int nLorem = sizeof(lorem) / sizeof(lorem[0]);
+        if (words > 0) {
+            std::string s = "//";
+            for (int i = 0; i < words; ++i) { s += ' '; s += lorem[pick(nLorem)]; }
+            line(s);
+            return;
+        }
+        line("/*");
+        for (int l = 0; l < opt.commentLines; ++l) {
+            std::string s = " *";
+            for (int i = 0, n = 6 + pick(8); i < n; ++i) { s += ' '; s += lorem[pick(nLorem)]; }
+            line(s);
+        }
+        line(" */");
+    }
+
+    // ── Scopes ────────────────────────────────────────────────
+    void declare(Var v) { scopes.back().push_back(std::move(v)); }
+
+    const Var* randomVar(bool scalar, bool objects) {
+        std::vector<const Var*> pool;
+        for (auto& sc : scopes)
+            for (auto& v : sc)
+                if (scalar  ? (v.cls < 0 && v.arrSize == 0)
+                    : objects ? v.cls >= 0 : v.arrSize > 0)
+                    pool.push_back(&v);
+        return pool.empty() ? nullptr : pool[pick((int)pool.size())];
+    }
+
+    // ── Expressions ───────────────────────────────────────────
+    std::string literal() {
+        if (chance(20)) return std::to_string(pick(100)) + "." + std::to_string(pick(10));
+        return std::to_string(pick(1000));
+    }
+
+    std::string args(int n, int budget) {
+        std::string s = "(";
+        for (int i = 0; i < n; ++i) {
+            if (i) s += ", ";
+            s += expr(1 + pick(budget), budget / 2);
+        }
+        return s + ")";
+    }
+
+    std::string leaf(int callBudget) {
+        switch (pick(10)) {
+            case 0: case 1:
+                return literal();
+            case 2:
+                if (callBudget > 0 && !fns.empty()) {
+                    const Fn& f = fns[pick((int)fns.size())];
+                    return f.name + args(f.arity, callBudget - 1);
+                }
+                return literal();
+            case 3:
+                if (const Var* a = randomVar(false, false))
+                    return a->name + "[" + std::to_string(pick(a->arrSize)) + "]";
+                break;
+            case 4:
+                if (const Var* o = randomVar(false, true)) {
+                    const Cls& c = classes[o->cls];
+                    if (chance(50)) return o->name + ".f" + std::to_string(pick(c.fields));
+                    if (callBudget > 0 && chance(50))
+                        return o->name + ".mix" + args(2, callBudget - 1);
+                    return o->name + ".get0()";
+                }
+                break;
+            case 5:
+                if (classFields > 0) return "this.f" + std::to_string(pick(classFields));
+                break;
+            case 6:
+                if (const Var* v = randomVar(true, false)) return (chance(50) ? "-" : "!") + v->name;
+                break;
+            default:
+                break;
+        }
+        if (const Var* v = randomVar(true, false)) return v->name;
+        return literal();
+    }
+
+    std::string expr(int terms, int callBudget = 2) {
+        static const char* ops[] = { "+", "-", "*", "/", "+", "*", "<", ">", "<=", ">=",
+                                     "==", "!=", "&&", "||" };
+        if (terms <= 1) return leaf(callBudget);
+        int left = 1 + pick(terms - 1);
+        std::string s = expr(left, callBudget) + " " + ops[pick(14)] + " "
+                      + expr(terms - left, callBudget);
+        return chance(30) ? "(" + s + ")" : s;
+    }
+
+    std::string fullExpr() { return expr(1 + pick(opt.exprTerms)); }
+
+    // ── Statements ────────────────────────────────────────────
+    void block(int n, int depth) {
+        scopes.emplace_back();
+        for (int i = 0; i < n; ++i) statement(depth);
+        scopes.pop_back();
+    }
+
+    void statement(int depth) {
+        switch (pick(12)) {
+            case 0: case 1: {
+                Var v{fresh("v")};
+                line((chance(25) ? "float " : "int ") + v.name + " = " + fullExpr() + ";");
+                declare(v);
+                return;
+            }
+            case 2: case 3:
+                if (const Var* v = randomVar(true, false)) {
+                    line(v->name + " = " + fullExpr() + ";");
+                    return;
+                }
+                break;
+            case 4:
+                if (depth < opt.depth) {
+                    line("if (" + expr(1 + pick(4)) + ") {");
+                    ++indent; block(1 + pick(opt.statements / 2 + 1), depth + 1); --indent;
+                    if (chance(60)) {
+                        line("} else {");
+                        ++indent; block(1 + pick(opt.statements / 2 + 1), depth + 1); --indent;
+                    }
+                    line("}");
+                    return;
+                }
+                break;
+            case 5:
+                if (depth < opt.depth) {
+                    Var w{fresh("w")};
+                    line("int " + w.name + " = 0;");
+                    declare(w);
+                    line("while (" + w.name + " < " + std::to_string(2 + pick(14)) + ") {");
+                    ++indent;
+                    block(1 + pick(opt.statements / 2 + 1), depth + 1);
+                    line(w.name + "++;");
+                    --indent;
+                    line("}");
+                    return;
+                }
+                break;
+            case 6:
+                if (depth < opt.depth) {
+                    Var i{fresh("i")};
+                    line("int " + i.name + ";");
+                    declare(i);
+                    line("for (" + i.name + " = 0; " + i.name + " < "
+                         + std::to_string(2 + pick(14)) + "; " + i.name + "++) {");
+                    ++indent; block(1 + pick(opt.statements / 2 + 1), depth + 1); --indent;
+                    line("}");
+                    return;
+                }
+                break;
+            case 7: {
+                Var a{fresh("a")};
+                a.arrSize = 4 + pick(13);
+                line("int " + a.name + "[" + std::to_string(a.arrSize) + "];");
+                declare(a);
+                for (int k = 0, n = 1 + pick(3); k < n; ++k)
+                    line(a.name + "[" + std::to_string(pick(a.arrSize)) + "] = " + fullExpr() + ";");
+                return;
+            }
+            case 8:
+                if (!classes.empty()) {
+                    Var o{fresh("o")};
+                    o.cls = pick((int)classes.size());
+                    const Cls& c = classes[o.cls];
+                    line(c.name + " " + o.name + ";");
+                    declare(o);
+                    line(o.name + ".set0(" + fullExpr() + ");");
+                    line(o.name + ".f" + std::to_string(pick(c.fields)) + " = " + fullExpr() + ";");
+                    return;
+                }
+                break;
+            case 9:
+                if (classFields > 0) {
+                    line("this.f" + std::to_string(pick(classFields)) + " = " + fullExpr() + ";");
+                    return;
+                }
+                if (!fns.empty()) {
+                    const Fn& f = fns[pick((int)fns.size())];
+                    line(f.name + args(f.arity, 1) + ";");
+                    return;
+                }
+                break;
+            case 10:
+                comment(4 + pick(8));
+                return;
+            default:
+                break;
+        }
+        Var v{fresh("v")};
+        line("int " + v.name + " = " + fullExpr() + ";");
+        declare(v);
+    }
+
+    // ── Declarations ──────────────────────────────────────────
+    std::string params(int arity) {
+        std::string s = "(";
+        for (int i = 0; i < arity; ++i) {
+            Var p{"p" + std::to_string(i)};
+            if (i) s += ", ";
+            s += (chance(25) ? "float " : "int ") + p.name;
+            declare(p);
+        }
+        return s + ")";
+    }
+
+    void function() {
+        Fn f{fresh("fn"), 1 + pick(3)};
+        if (chance(40)) comment(0);
+        scopes.emplace_back();
+        line((chance(20) ? "float " : "int ") + f.name + params(f.arity) + " {");
+        ++indent;
+        block(opt.statements, 0);
+        line("return " + fullExpr() + ";");
+        --indent;
+        line("}");
+        line("");
+        scopes.pop_back();
+        fns.push_back(f);   // only callable after its definition
+    }
+
+    void classDecl() {
+        Cls c{fresh("C"), 2 + pick(4)};
+        comment(0);
+        line("class " + c.name + " {");
+        ++indent;
+        for (int i = 0; i < c.fields; ++i)
+            line((i == 0 || chance(70) ? "int f" : "float f") + std::to_string(i) + ";");
+        line("");
+        line("void set0(int v) {");
+        line("    this.f0 = v;");
+        line("}");
+        line("int get0() {");
+        line("    return this.f0;");
+        line("}");
+
+        classFields = c.fields;
+        scopes.emplace_back();
+        line("int mix" + params(2) + " {");
+        ++indent;
+        block(opt.statements / 2 + 1, opt.depth / 2);
+        line("return " + fullExpr() + ";");
+        --indent;
+        line("}");
+        scopes.pop_back();
+        classFields = 0;
+
+        --indent;
+        line("}");
+        line("");
+        classes.push_back(c);
+    }
+
+    void mainFunction() {
+        line("int main() {");
+        ++indent;
+        scopes.emplace_back();
+        line("int total = 0;");
+        declare(Var{"total"});
+        for (int i = 0, n = std::min<int>((int)fns.size(), 16); i < n; ++i) {
+            const Fn& f = fns[pick((int)fns.size())];
+            line("total = total + " + f.name + args(f.arity, 0) + ";");
+        }
+        line("return 0;");
+        scopes.pop_back();
+        --indent;
+        line("}");
+    }
+};
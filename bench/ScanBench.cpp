@@ -0,0 +1,151 @@
+// ============================================================
+//  Lexer character-scanning benchmark
+//
+//  Compares the vectorised whitespace / comment scanners in
+//  lexer/CharScan.h against their scalar reference versions:
+//
+//   1. equivalence — every scanner is run from every offset of a
+//      random buffer drawn from " \t\n\v\f\r*/ab" and must return
+//      the same position and line count as the scalar version;
+//   2. throughput  — a comment-heavy source (the test/*.mc programs
+//      with their comments inflated) is walked with a minimal
+//      skip-whitespace-and-comments loop, reporting MB/s.
+//
+//  Usage:  ./bench_scan [test-dir=test] [megabytes=32] [rounds=10]
+// ============================================================
+
+#include "lexer/CharScan.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+struct Scalar {
+    static const char* ws(const char* p, const char* e, int& l)  { return scalar_scan::skipWhitespace(p, e, l); }
+    static const char* eol(const char* p, const char* e)         { return scalar_scan::findLineEnd(p, e); }
+    static const char* blk(const char* p, const char* e, int& l) { return scalar_scan::findBlockCommentEnd(p, e, l); }
+};
+struct Simd {
+    static const char* ws(const char* p, const char* e, int& l)  { return simd_scan::skipWhitespace(p, e, l); }
+    static const char* eol(const char* p, const char* e)         { return simd_scan::findLineEnd(p, e); }
+    static const char* blk(const char* p, const char* e, int& l) { return simd_scan::findBlockCommentEnd(p, e, l); }
+};
+
+// Skip whitespace and comments the way Lexer::scan() does, stepping one
+// byte over everything else.  Returns a checksum of the stop positions.
+template <typename Impl>
+static uint64_t walk(const std::string& text, int& line) {
+    const char* p   = text.data();
+    const char* end = p + text.size();
+    uint64_t sum = 0;
+    line = 1;
+    while (p < end) {
+        if (scalar_scan::isSpace((unsigned char)*p)) {
+            p = Impl::ws(p, end, line);
+        } else if (p[0] == '/' && p + 1 < end && p[1] == '/') {
+            p = Impl::eol(p + 2, end);
+        } else if (p[0] == '/' && p + 1 < end && p[1] == '*') {
+            p = Impl::blk(p + 2, end, line);
+            p += (p + 1 < end) ? 2 : 1;
+        } else {
+            ++p;
+        }
+        sum = sum * 31 + (uint64_t)(p - text.data());
+    }
+    return sum;
+}
+
+static bool checkEquivalence() {
+    const char alphabet[] = " \t\n\v\f\r*/ab";
+    uint64_t state = 0x243F6A8885A308D3ull;
+    std::string buf(4096, ' ');
+    for (char& c : buf) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        c = alphabet[(state >> 33) % (sizeof(alphabet) - 1)];
+    }
+    const char* b = buf.data();
+    for (size_t len : {buf.size(), buf.size() - 7, (size_t)33, (size_t)17, (size_t)1}) {
+        const char* end = b + len;
+        for (const char* p = b; p <= end; ++p) {
+            int l1 = 0, l2 = 0;
+            if (Scalar::ws(p, end, l1) != Simd::ws(p, end, l2) || l1 != l2 ||
+                Scalar::eol(p, end) != Simd::eol(p, end) ||
+                Scalar::blk(p, end, l1) != Simd::blk(p, end, l2) || l1 != l2) {
+                std::cerr << "MISMATCH at offset " << (p - b) << " (length " << len << ")\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// test/*.mc concatenated, with every comment padded out so that comments
+// and indentation dominate the byte count, repeated up to 'bytes'.
+static std::string makeSource(const fs::path& dir, size_t bytes) {
+    std::string unit;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() != ".mc") continue;
+        std::ifstream in(entry.path());
+        std::stringstream ss;
+        ss << in.rdbuf();
+        unit += "/*\n * " + entry.path().filename().string() + "\n"
+                "       " + std::string(120, '=') + "\n */\n";
+        std::string line;
+        while (std::getline(ss, line)) {
+            unit += "        " + line;
+            if (line.find("//") != std::string::npos) unit += std::string(60, '-');
+            unit += '\n';
+        }
+    }
+    if (unit.empty()) return unit;
+    std::string out;
+    out.reserve(bytes + unit.size());
+    while (out.size() < bytes) out += unit;
+    return out;
+}
+
+template <typename Impl>
+static double timeIt(const std::string& text, int rounds, uint64_t& sum, int& lines) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) sum += walk<Impl>(text, lines);
+    auto t1 = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    return (double)text.size() * rounds / sec / (1024.0 * 1024.0);
+}
+
+int main(int argc, char* argv[]) {
+    fs::path dir  = argc > 1 ? argv[1] : "test";
+    size_t   mb   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 32;
+    int    rounds = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    if (!checkEquivalence()) return 1;
+
+    std::string text = makeSource(dir, mb << 20);
+    if (text.empty()) { std::cerr << "no .mc files in " << dir << "\n"; return 1; }
+
+    uint64_t sumScalar = 0, sumSimd = 0;
+    int linesScalar = 0, linesSimd = 0;
+    double scalarMBs = timeIt<Scalar>(text, rounds, sumScalar, linesScalar);
+    double simdMBs   = timeIt<Simd>(text, rounds, sumSimd, linesSimd);
+    if (sumScalar != sumSimd || linesScalar != linesSimd) {
+        std::cerr << "walk mismatch\n";
+        return 1;
+    }
+
+    const char* isa = !simd_scan::kVectorized ? "scalar fallback"
+                    : simd_scan::kWidth == 32 ? "AVX2" : "SSE2";
+    std::cout << std::fixed << std::setprecision(1)
+              << "input: " << (text.size() >> 20) << " MiB, " << linesScalar
+              << " lines  rounds: " << rounds << "  vector path: " << isa << "\n"
+              << "  scalar : " << scalarMBs << " MB/s\n"
+              << "  simd   : " << simdMBs   << " MB/s\n"
+              << "  speedup: " << simdMBs / scalarMBs << "x\n";
+    return 0;
+}
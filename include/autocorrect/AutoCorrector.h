@@ -2,6 +2,7 @@
 #include "lexer/Lexer.h"
 #include "parser/Parser.h"
 #include "codegen/CodeGen.h"
+#include "utils/SourceBuffer.h"
 #include <string>
 #include <vector>
 #include <set>
@@ -16,7 +17,7 @@ struct Correction {
 
 class AutoCorrector {
 public:
-    AutoCorrector(const std::string&               source,
+    AutoCorrector(const SourceBuffer&              source,
                   const std::vector<LexError>&     lexErrors,
                   const std::vector<ParseError>&   parseErrors,
                   const std::vector<CodeGenError>& cgErrors);
@@ -1,9 +1,11 @@
 #pragma once
 #include "parser/AST.h"
-#include "semantic/SymbolTable.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Target/TargetMachine.h>
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include <string>
@@ -38,19 +40,69 @@ struct CodeGenError {
     std::string message;
 };
 
+// ── Integer semantics ─────────────────────────────────────────
+// Signed overflow of int + - * and unary minus:
+enum class IntSemantics {
+    Wrap,    // two's complement wrap-around (default)
+    NSW,     // undefined: emitted with nsw, so loops can be widened
+    Trap     // checked: overflow executes llvm.trap
+};
+
+// Int division by zero (a constant non-zero divisor is never checked):
+enum class DivSemantics {
+    Safe,       // x / 0 == x: the divisor is replaced by 1 (default)
+    Unchecked,  // undefined: a bare sdiv
+    Trap        // checked: a zero divisor executes llvm.trap
+};
+
+// ── Floating point ────────────────────────────────────────────
+// Fusing a * b + c into one rounding step (FMA):
+enum class FPContract {
+    Off,     // never (default): results match the unfused expression
+    On,      // within one expression, via llvm.fmuladd
+    Fast     // anywhere: every float op carries the 'contract' flag
+};
+
+struct CodeGenOptions {
+    // Lean mode (--release) drops everything only diagnostics read: IR
+    // value names, the symbol log, and per-function verification (the
+    // module is verified once, at the end of the program).
+    bool         lean         = false;
+    IntSemantics intSemantics = IntSemantics::Wrap;
+    DivSemantics div          = DivSemantics::Safe;
+    // --fast-math: every fast-math flag on all float ops (implies
+    // contraction); the 'fast' function modifier does the same per function.
+    bool         fastMath     = false;
+    FPContract   fpContract   = FPContract::Off;
+    // Code is generated and optimized for the host triple.  Empty means
+    // the triple's generic CPU; "native" (-march=native) the host CPU and
+    // every feature it has.  Features are LLVM's "+avx2,-fma" form.
+    std::string  targetCPU;
+    std::string  targetFeatures;
+    // The machine for the two above, made once by the driver with
+    // CodeGen::createTargetMachine() and shared by every CodeGen of the
+    // run.  Null: each CodeGen makes its own (tools, benchmarks).
+    std::shared_ptr<llvm::TargetMachine> target;
+    // Partial objects an executable is linked from, each generated on a
+    // thread of its own (--codegen-threads); 1 is a single object.
+    unsigned     codegenThreads = 1;
+};
+
 // ── Class metadata stored during codegen ─────────────────────
 struct ClassInfo {
-    std::string name;
-    std::vector<std::pair<std::string, ValueType>> fields;  // (fieldName, type) in order
+    Atom name;
+    std::vector<std::pair<Atom, ValueType>> fields;  // (fieldName, type) in order
     llvm::StructType* llvmType = nullptr;
+    std::unordered_map<Atom, llvm::Function*> methods;   // method name → @Class_method
 
-    int fieldIndex(const std::string& fname) const {
+    // Classes have a handful of fields: a scan of atom compares beats hashing.
+    int fieldIndex(Atom fname) const {
         for (int i = 0; i < (int)fields.size(); i++)
             if (fields[i].first == fname) return i;
         return -1;
     }
 
-    ValueType fieldType(const std::string& fname) const {
+    ValueType fieldType(Atom fname) const {
         for (auto& [n, t] : fields)
             if (n == fname) return t;
         return ValueType::Unknown;
@@ -59,41 +111,116 @@ struct ClassInfo {
 
 class CodeGen {
 public:
-    CodeGen();
+    explicit CodeGen(const CodeGenOptions& opts = {});
+
+    // The machine for opts' CPU and features on the host triple; null
+    // with 'error' set if the target, CPU or a feature is unknown.
+    static std::unique_ptr<llvm::TargetMachine> createTargetMachine(const CodeGenOptions& opts,
+                                                                    std::string& error);
 
+    // Expects a program the Resolver bound and the Checker accepted: the
+    // checker reports every semantic error, CodeGen only I/O, verifier
+    // and "[CodeGen] Internal:" errors for a broken invariant.
     llvm::Value* generate(AST* node);
     void         optimize(OptLevel level = OptLevel::O2);
+    // optimize()'s pass pipeline alone, for any module (the lazy JIT
+    // runs it on one function at a time).
+    static void  runPipeline(llvm::Module& m, OptLevel level, llvm::TargetMachine* target);
     std::string  getIRString() const;
     llvm::Value* toBool(llvm::Value* val);
-    void         dumpToFile(const std::string& filename);
+    bool         dumpToFile(const std::string& filename);   // textual IR
     void         dump();
 
+    // In-process output from the module as it stands.  Machine code is
+    // emitted by the TargetMachine (PIC, llc's default -O2 codegen); its
+    // passes rewrite the IR, so IR outputs are written first.
+    bool         writeBitcode(const std::string& filename);
+    bool         emitFile(const std::string& filename, bool assembly);   // .s / .o
+    // One object per name, generated in parallel: the module is split
+    // (llvm::splitCodeGen) and each part compiled on its own thread, in
+    // its own LLVMContext, by a copy of the TargetMachine.
+    bool         emitObjects(const std::vector<std::string>& filenames);
+
     bool hasErrors() const { return !errors.empty(); }
     const std::vector<CodeGenError>&   getErrors()   const { return errors; }
     const OptStats&                    getOptStats() const { return optStats; }
-    const std::vector<SymbolLogEntry>& getSymbolLog()const { return symbols.getLog(); }
+    const llvm::Module&                getModule()   const { return *module; }
+    const llvm::TargetMachine*         getTargetMachine() const { return targetMachine.get(); }
+    const CodeGenOptions&              getOptions()  const { return opts; }
+
+    // Hands the module and its context over (to the JIT).  Nothing may
+    // be generated, optimized or emitted afterwards.
+    llvm::orc::ThreadSafeModule takeModule();
 
     // Class registry — for debug/report
-    const std::unordered_map<std::string, ClassInfo>& getClassInfos() const { return classInfos; }
+    const std::unordered_map<Atom, ClassInfo>& getClassInfos() const { return classInfos; }
 
 private:
-    llvm::LLVMContext              context;
+    std::unique_ptr<llvm::LLVMContext> ownedContext;   // null after takeModule()
+    llvm::LLVMContext&             context;
     llvm::IRBuilder<>              builder;
     std::unique_ptr<llvm::Module>  module;
-    SymbolTable                    symbols;
     std::vector<llvm::BasicBlock*> breakStack;
     std::vector<llvm::BasicBlock*> continueStack;
+    std::vector<size_t>            loopScopes;     // scopeAllocas.size() at each loop body
     std::vector<CodeGenError>      errors;
     OptStats                       optStats;
+    CodeGenOptions                 opts;
+    std::shared_ptr<llvm::TargetMachine> targetMachine;   // sets triple, DataLayout, TTI
 
     // ── OOP state ─────────────────────────────────────────────
-    std::unordered_map<std::string, llvm::StructType*> classTypes;   // class name → LLVM struct type
-    std::unordered_map<std::string, ClassInfo>         classInfos;   // class name → metadata
-    std::string   currentClassName;    // non-empty while generating a method
+    std::unordered_map<Atom, llvm::StructType*> classTypes;   // class name → LLVM struct type
+    std::unordered_map<Atom, ClassInfo>         classInfos;   // class name → metadata
+    std::unordered_map<Atom, llvm::Function*>   functions;    // callable name → function
+    Atom          currentClassName;    // non-empty while generating a method
     llvm::Value*  currentThisAlloca;   // alloca of ClassName* inside current method
 
+    // ── Resolved locals ───────────────────────────────────────
+    // The current function's locals by Resolver slot, filled as their
+    // declarations are generated.  In a checked program every reference
+    // is bound and reads its entry directly.
+    struct Local {
+        llvm::Value* value = nullptr;
+        ValueType    type  = ValueType::Unknown;
+        Atom         objectClass;    // for objects
+    };
+    std::vector<Local> locals;
+
+    const Local* local(int slot) const {
+        return slot >= 0 && (size_t)slot < locals.size() && locals[slot].value ? &locals[slot] : nullptr;
+    }
+    void setLocal(int slot, llvm::Value* value, ValueType type, Atom objectClass = Atom()) {
+        if (slot >= 0 && (size_t)slot < locals.size()) locals[slot] = {value, type, objectClass};
+    }
+
+    // ── Stack slots ───────────────────────────────────────────
+    // Every alloca goes to the top of the entry block, so mem2reg can
+    // promote it and a loop body does not grow the stack each time round.
+    // A block's locals are bracketed by lifetime markers (ended on every
+    // exit from the scope) so sibling scopes can share stack slots.
+    llvm::AllocaInst*                           lastAlloca = nullptr;   // in the current entry block
+    std::vector<std::vector<llvm::AllocaInst*>> scopeAllocas;           // per open block
+    llvm::BasicBlock*                           trapBlock  = nullptr;   // current function's, made on demand
+
+    llvm::AllocaInst* entryAlloca(llvm::Type* ty, const llvm::Twine& name);
+    llvm::AllocaInst* scopedAlloca(llvm::Type* ty, const llvm::Twine& name);
+    void              endLifetimes(size_t fromScope);   // scopes fromScope.. innermost
+
+    // ── Integer arithmetic ────────────────────────────────────
+    void         trapIf(llvm::Value* cond, const llvm::Twine& contName);
+    llvm::Value* intArith(llvm::Instruction::BinaryOps op, llvm::Value* l, llvm::Value* r,
+                          const llvm::Twine& name);
+    llvm::Value* intDiv(llvm::Value* l, llvm::Value* r);
+
+    // ── Function attributes ───────────────────────────────────
+    void         setFunctionAttrs(llvm::Function* fn, const PrototypeAST* proto);
+
+    // ── Float arithmetic ──────────────────────────────────────
+    llvm::Value* fusedMulAdd(llvm::Value* l, llvm::Value* r, bool sub);
+
     // ── Helpers ───────────────────────────────────────────────
-    void addError(const std::string& msg);
+    void           addError(const std::string& msg);
+    std::nullptr_t internalError(const char* what);   // reports, returns null
     void collectStats(OptStats::FuncStat& fs, llvm::Function& fn, bool before);
 
     llvm::Type*  llvmType(ASTType   t);
@@ -101,20 +228,32 @@ private:
     llvm::Value* coerce(llvm::Value* val, llvm::Type* targetTy);
     std::pair<llvm::Value*, llvm::Value*> promoteToCommon(llvm::Value* lhs, llvm::Value* rhs);
 
+    // ── Operator trees ────────────────────────────────────────
+    // Generated by operators() on these stacks instead of recursively; a
+    // nested call resumes above its caller's entries.  Stage 0 expands a
+    // node, 1 has its first operand on opValues, 2 (&&, || only) its
+    // second; rhsBB/mergeBB/lhsBB are the short-circuit blocks.
+    struct OpFrame {
+        AST*              node;
+        uint8_t           stage   = 0;
+        llvm::BasicBlock* rhsBB   = nullptr;
+        llvm::BasicBlock* mergeBB = nullptr;
+        llvm::BasicBlock* lhsBB   = nullptr;
+    };
+    std::vector<OpFrame>      opFrames;
+    std::vector<llvm::Value*> opValues;
+    llvm::Value* operators(AST* root);
+    llvm::Value* binaryOp(BinOp op, llvm::Value* lhs, llvm::Value* rhs);
+
     // ── OOP helpers ───────────────────────────────────────────
     // Generate a class method (prepends implicit this* parameter)
     void generateMethod(FunctionAST* f,
-                        const std::string& className,
+                        Atom               className,
                         llvm::StructType*  structTy);
 
-    // Resolve a field GEP for an object symbol
-    llvm::Value* fieldGEP(const Symbol* sym,
-                          const std::string& fieldName,
-                          const std::string& tag = "");
-
     // Resolve a field GEP using an explicit struct pointer value
     llvm::Value* fieldGEPFromPtr(llvm::StructType* structTy,
                                   llvm::Value*      objPtr,
                                   int               fieldIdx,
-                                  const std::string& tag = "");
+                                  const llvm::Twine& tag = "");
 };
@@ -0,0 +1,64 @@
+#pragma once
+#include "codegen/CodeGen.h"
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Target/TargetMachine.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ── In-process execution (--jit) ──────────────────────────────
+//
+// One ORC LLJIT, for the same CPU and features the optimizer targeted
+// and with the backend effort of the --O level (O0 selects instructions
+// the fast way, as clang -O0 does), runs any number of finished modules
+// one after another: each is added, its main() called in this process,
+// and its code freed again.  A crash in the program (a trap, a bad
+// access, a stack overflow) is caught and reported as 128 + the signal,
+// as a shell would report the native binary.
+//
+// A lazy JIT (--jit=lazy) compiles nothing up front: main() and every
+// function it reaches are optimized and compiled one by one on their
+// first call, through ORC's compile-on-demand layer and lazy reexports.
+class JIT {
+public:
+    // Lazy compiles, per function, on first call.
+    struct LazyStats {
+        struct Compiled {
+            std::string name;
+            double      ms = 0;     // optimize + compile, added to its first call
+        };
+        size_t                functions = 0;   // defined in the module
+        std::vector<Compiled> compiled;        // in first-call order
+    };
+
+    JIT(const llvm::TargetMachine& target, OptLevel level, bool lazy = false);
+
+    // main()'s result as an exit status (0-255), or -1 with getError()
+    // set if the module could not be compiled or has no main.  A lazy
+    // JIT runs the --O pipeline itself unless 'optimized' says the
+    // module has been through it already.
+    int run(llvm::orc::ThreadSafeModule module, bool optimized = true);
+
+    bool               isLazy()       const { return lazy; }
+    const LazyStats&   getLazyStats() const { return stats; }
+    const std::string& getError()     const { return error; }
+
+private:
+    llvm::orc::JITTargetMachineBuilder jtmb;
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    std::unique_ptr<llvm::TargetMachine> optTarget;   // the lazy pipeline's cost model
+    OptLevel                          level;
+    bool                              lazy;
+    bool                              optimizeLazily = false;
+    LazyStats                         stats;
+    struct Pending {
+        std::string                           names;
+        std::chrono::steady_clock::time_point start;
+    };
+    std::unordered_map<const void*, Pending> pending;   // by MaterializationResponsibility
+    std::string                       error;
+
+    bool createLazy();
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ── Bulk character scanning for the lexer ─────────────────────
+//
+// The three loops where the lexer walks long runs of uninteresting bytes:
+//
+//   skipWhitespace     first byte that is not isspace(), counting '\n'
+//   findLineEnd        first '\n' (end of a // comment)
+//   findBlockCommentEnd  first "*/", counting '\n' on the way; when there
+//                      is none it stops on the last byte, exactly where
+//                      the original byte loop gave up (pos + 1 < size)
+//
+// Each has a scalar reference version (scalar_scan::) and a vector version
+// (simd_scan::) that processes 32 bytes per step with AVX2, 16 with SSE2,
+// and falls back to the scalar code on other targets and for the tail of
+// the buffer.  Both produce identical positions and line counts.
+// 'line' is only ever incremented.
+
+namespace scalar_scan {
+
+inline bool isSpace(unsigned char c) {
+    return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t';
+}
+
+inline const char* skipWhitespace(const char* p, const char* end, int& line) {
+    for (; p < end && isSpace((unsigned char)*p); ++p)
+        if (*p == '\n') ++line;
+    return p;
+}
+
+inline const char* findLineEnd(const char* p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    return p;
+}
+
+inline const char* findBlockCommentEnd(const char* p, const char* end, int& line) {
+    for (; p + 1 < end; ++p) {
+        if (*p == '\n') ++line;
+        else if (p[0] == '*' && p[1] == '/') return p;
+    }
+    return p;
+}
+
+} // namespace scalar_scan
+
+namespace simd_scan {
+
+#if defined(__AVX2__)
+constexpr size_t kWidth = 32;
+using Mask = uint32_t;
+using Vec  = __m256i;
+inline Vec  load(const char* p)      { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline Vec  splat(char c)            { return _mm256_set1_epi8(c); }
+inline Vec  eq(Vec a, Vec b)         { return _mm256_cmpeq_epi8(a, b); }
+inline Vec  lanesOr(Vec a, Vec b)    { return _mm256_or_si256(a, b); }
+inline Vec  lanesAnd(Vec a, Vec b)   { return _mm256_and_si256(a, b); }
+inline Vec  sub(Vec a, Vec b)        { return _mm256_sub_epi8(a, b); }
+inline Vec  minU(Vec a, Vec b)       { return _mm256_min_epu8(a, b); }
+inline Mask bits(Vec v)              { return (Mask)_mm256_movemask_epi8(v); }
+#elif defined(__SSE2__)
+constexpr size_t kWidth = 16;
+using Mask = uint32_t;
+using Vec  = __m128i;
+inline Vec  load(const char* p)      { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline Vec  splat(char c)            { return _mm_set1_epi8(c); }
+inline Vec  eq(Vec a, Vec b)         { return _mm_cmpeq_epi8(a, b); }
+inline Vec  lanesOr(Vec a, Vec b)    { return _mm_or_si128(a, b); }
+inline Vec  lanesAnd(Vec a, Vec b)   { return _mm_and_si128(a, b); }
+inline Vec  sub(Vec a, Vec b)        { return _mm_sub_epi8(a, b); }
+inline Vec  minU(Vec a, Vec b)       { return _mm_min_epu8(a, b); }
+inline Mask bits(Vec v)              { return (Mask)_mm_movemask_epi8(v); }
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+constexpr bool kVectorized = true;
+
+inline int lowBits(Mask m, unsigned n) {   // popcount of m's lowest n bits
+    return __builtin_popcount(n >= 32 ? m : m & ((1u << n) - 1));
+}
+
+inline const char* skipWhitespace(const char* p, const char* end, int& line) {
+    const Vec nl = splat('\n'), sp = splat(' '), tab = splat('\t'), four = splat(4);
+    while ((size_t)(end - p) >= kWidth) {
+        Vec v  = load(p);
+        Vec lo = sub(v, tab);                        // '\t'..'\r' -> 0..4
+        Vec ws = lanesOr(eq(v, sp), eq(minU(lo, four), lo));
+        Mask notWs = ~bits(ws);
+        Mask nls   = bits(eq(v, nl));
+        if (kWidth < 32) notWs &= (Mask)((1ull << kWidth) - 1);
+        if (notWs) {
+            unsigned n = (unsigned)__builtin_ctz(notWs);
+            line += lowBits(nls, n);
+            return p + n;
+        }
+        line += __builtin_popcount(nls);
+        p += kWidth;
+    }
+    return scalar_scan::skipWhitespace(p, end, line);
+}
+
+inline const char* findLineEnd(const char* p, const char* end) {
+    const Vec nl = splat('\n');
+    while ((size_t)(end - p) >= kWidth) {
+        if (Mask m = bits(eq(load(p), nl)))
+            return p + __builtin_ctz(m);
+        p += kWidth;
+    }
+    return scalar_scan::findLineEnd(p, end);
+}
+
+inline const char* findBlockCommentEnd(const char* p, const char* end, int& line) {
+    const Vec nl = splat('\n'), star = splat('*'), slash = splat('/');
+    // Needs kWidth + 1 bytes: the '/' of a "*/" may sit one past the block.
+    while ((size_t)(end - p) > kWidth) {
+        Vec v    = load(p);
+        Mask hit = bits(lanesAnd(eq(v, star), eq(load(p + 1), slash)));
+        Mask nls = bits(eq(v, nl));
+        if (hit) {
+            unsigned n = (unsigned)__builtin_ctz(hit);
+            line += lowBits(nls, n);
+            return p + n;
+        }
+        line += __builtin_popcount(nls);
+        p += kWidth;
+    }
+    return scalar_scan::findBlockCommentEnd(p, end, line);
+}
+#else
+constexpr bool   kVectorized = false;
+constexpr size_t kWidth      = 1;
+using scalar_scan::skipWhitespace;
+using scalar_scan::findLineEnd;
+using scalar_scan::findBlockCommentEnd;
+#endif
+
+} // namespace simd_scan
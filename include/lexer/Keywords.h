@@ -0,0 +1,67 @@
+#pragma once
+#include "Token.h"
+#include <array>
+#include <string_view>
+
+// ── Keyword recognition (compile-time perfect hash) ───────────
+//
+//  slot = (first_char * 5 + last_char * 4) & 31
+//
+//  is collision-free over the language keywords (enforced by the
+//  static_assert below), so an identifier is classified with a single
+//  table probe plus one string_view compare.  Adding a keyword that
+//  collides breaks the build instead of silently mis-lexing.
+
+struct KeywordEntry {
+    std::string_view spelling;
+    TokenType        type = TokenType::IDENT;
+};
+
+inline constexpr KeywordEntry kKeywords[] = {
+    {"int",      TokenType::INT},
+    {"float",    TokenType::FLOAT},
+    {"void",     TokenType::VOID},
+    {"return",   TokenType::RETURN},
+    {"if",       TokenType::IF},
+    {"else",     TokenType::ELSE},
+    {"while",    TokenType::WHILE},
+    {"for",      TokenType::FOR},
+    {"break",    TokenType::BREAK},
+    {"continue", TokenType::CONTINUE},
+    {"class",    TokenType::CLASS},
+    {"new",      TokenType::NEW},
+    {"this",     TokenType::THIS},
+    {"public",   TokenType::PUBLIC},
+    {"private",  TokenType::PRIVATE},
+};
+
+constexpr size_t kKeywordSlots = 32;
+
+constexpr size_t keywordSlot(std::string_view s) {
+    return ((unsigned char)s.front() * 5u + (unsigned char)s.back() * 4u)
+           & (kKeywordSlots - 1);
+}
+
+constexpr std::array<KeywordEntry, kKeywordSlots> buildKeywordTable() {
+    std::array<KeywordEntry, kKeywordSlots> table{};
+    for (const auto& kw : kKeywords) table[keywordSlot(kw.spelling)] = kw;
+    return table;
+}
+
+inline constexpr auto kKeywordTable = buildKeywordTable();
+
+constexpr bool keywordTableIsPerfect() {
+    for (const auto& kw : kKeywords)
+        if (kKeywordTable[keywordSlot(kw.spelling)].spelling != kw.spelling)
+            return false;
+    return true;
+}
+static_assert(keywordTableIsPerfect(),
+              "keyword hash collision: pick new multipliers in keywordSlot()");
+
+// Returns the keyword TokenType for 'id', or TokenType::IDENT.
+// 'id' must be non-empty (the lexer only calls this on [A-Za-z_]...).
+constexpr TokenType lookupKeyword(std::string_view id) {
+    const KeywordEntry& e = kKeywordTable[keywordSlot(id)];
+    return e.spelling == id ? e.type : TokenType::IDENT;
+}
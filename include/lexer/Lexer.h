@@ -3,6 +3,7 @@
 #include "Token.h"
 #include <vector>
 #include <string>
+#include <string_view>
 
 struct LexError {
     int         line;
@@ -11,20 +12,27 @@ struct LexError {
 
 class Lexer {
 public:
-    explicit Lexer(const std::string& src, bool keepComments = true);
-    std::vector<Token> tokenize();
+    // 'src' is not copied: it must stay alive as long as the returned tokens.
+    explicit Lexer(std::string_view src, bool keepComments = true);
 
+    // The next token (TokenStream drains the lexer this way); EOF_TOK
+    // forever once the source is exhausted.
+    Token next();
+
+    std::string_view source() const { return src; }
     bool hasErrors() const { return !errors.empty(); }
+    int  commentCount() const { return comments; }   // comment tokens produced so far
     const std::vector<LexError>& getErrors() const { return errors; }
 
 private:
-    std::string           src;
+    std::string_view      src;
     size_t                pos;
     int                   line;
     bool                  keepComments;  // if false, drop comment tokens (compat mode)
+    int                   comments = 0;
     std::vector<LexError> errors;
 
-    char getChar();
+    Token token(TokenType t, size_t start, int tokLine) const;   // lexeme = src[start, pos)
     char peek() const;
     void addError(const std::string& msg);
 };
@@ -1,7 +1,9 @@
 #pragma once
-#include <string>
+#include "utils/Atom.h"
+#include <cstdint>
+#include <string_view>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     // ── Keywords ─────────────────────────────────────────────
     INT, FLOAT, RETURN,
     IF, ELSE, WHILE, FOR,
@@ -39,8 +41,12 @@ enum class TokenType {
     EOF_TOK
 };
 
+// The lexeme is a view into the source buffer handed to the Lexer, so
+// tokens never allocate.  The buffer must outlive every token produced
+// from it.  Identifiers also carry their interned name.
 struct Token {
-    TokenType   type;
-    std::string lexeme;
-    int         line = 0;
+    TokenType        type;
+    std::string_view lexeme;
+    int              line = 0;
+    Atom             atom = {};     // IDENT only
 };
@@ -0,0 +1,45 @@
+#pragma once
+#include "Lexer.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// ── Struct-of-arrays token storage ────────────────────────────
+//
+// The whole token sequence in dense parallel arrays: one byte of TokenType
+// per token, the lexeme's source offset/length, the line and the interned
+// identifier.  The parser's hot type checks only touch types[], so a
+// cache line holds 64 tokens instead of about one.  Lexemes are rebuilt
+// as views into the source on demand.
+//
+// The sequence ends with one EOF_TOK plus kPadding more EOF_TOK sentinels,
+// so type(i + k) is valid for any cursor i at or before the real EOF and
+// any k < kPadding — readers never bounds-check.
+class TokenStream {
+public:
+    static constexpr size_t kPadding = 4;   // the parser looks 3 tokens ahead
+
+    // Drains 'lexer' to EOF before parsing starts: the parallel parser
+    // splits the whole sequence up front and the token dump reads it
+    // back afterwards.  The lexer's source must outlive the stream.
+    explicit TokenStream(Lexer& lexer);
+
+    size_t size() const { return count; }            // tokens up to and including EOF
+
+    TokenType        type(size_t i)   const { return types[i]; }
+    int              line(size_t i)   const { return lines[i]; }
+    std::string_view lexeme(size_t i) const { return src.substr(offsets[i], lengths[i]); }
+    Atom             atom(size_t i)   const { return atoms[i]; }      // IDENT only
+    Token            at(size_t i)     const { return {types[i], lexeme(i), lines[i], atoms[i]}; }
+
+private:
+    std::string_view       src;
+    size_t                 count = 0;
+    std::vector<TokenType> types;
+    std::vector<uint32_t>  offsets;
+    std::vector<uint32_t>  lengths;
+    std::vector<int>       lines;
+    std::vector<Atom>      atoms;
+
+    void push(const Token& t);
+};
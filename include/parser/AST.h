@@ -1,9 +1,15 @@
 #ifndef AST_H
 #define AST_H
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <iostream>
+#include "ASTArena.h"
+#include "semantic/ValueType.h"
+#include "utils/Atom.h"
 
 // ── Language value types ──────────────────────────────────────
 enum class ASTType {
@@ -23,29 +29,110 @@ static inline std::string astTypeName(ASTType t) {
     return "<unknown>";
 }
 
+// ── Node kinds ────────────────────────────────────────────────
+// One tag per concrete node type, stored in every node so passes can
+// switch on it instead of probing with dynamic_cast.
+enum class ASTKind : uint8_t {
+    LineComment, BlockComment,
+    Number, Float, Variable,
+    Binary, Logical, Unary, PostInc,
+    Return, VarDecl, Assign, VarDeclInit, Block, If, While, For, Break, Continue,
+    ArrayDecl, ArrayAccess, ArrayAssign,
+    Prototype, Function, Call,
+    ClassDecl, ObjectDecl, MemberAccess, MemberAssign, MethodCall, ThisAccess, ThisAssign,
+    Program,
+};
+
+// ── Operators ─────────────────────────────────────────────────
+// Set by the parser from the operator token.  Eq/Ne/And/Or appear on
+// LogicalAST, the rest on BinaryAST.
+enum class BinOp : uint8_t {
+    Add, Sub, Mul, Div,
+    Lt, Gt, Le, Ge,
+    Eq, Ne, And, Or,
+};
+
+enum class UnOp : uint8_t { Neg, Not };
+
+inline const char* opSpelling(BinOp op) {
+    switch (op) {
+        case BinOp::Add: return "+";
+        case BinOp::Sub: return "-";
+        case BinOp::Mul: return "*";
+        case BinOp::Div: return "/";
+        case BinOp::Lt:  return "<";
+        case BinOp::Gt:  return ">";
+        case BinOp::Le:  return "<=";
+        case BinOp::Ge:  return ">=";
+        case BinOp::Eq:  return "==";
+        case BinOp::Ne:  return "!=";
+        case BinOp::And: return "&&";
+        case BinOp::Or:  return "||";
+    }
+    return "?";
+}
+
+inline const char* opSpelling(UnOp op) { return op == UnOp::Neg ? "-" : "!"; }
+
 // ── Base ──────────────────────────────────────────────────────
+// Nodes live in the ProgramAST's ASTArena and are never deleted one by
+// one: child links are plain pointers, child lists are ArenaLists, text
+// is a view into the arena, and no node may own heap memory.
 struct AST {
-    virtual ~AST() = default;
+    const ASTKind kind;
+    ValueType     valueType = ValueType::Unknown;   // set by the Resolver
+
+
     virtual void print(int indent = 0) const = 0;
     virtual bool isNoOp() const { return false; }
-};
+protected:
+    explicit AST(ASTKind k) : kind(k) {}
+    ~AST() = default;
+};
+
+// Concrete nodes derive from ASTNode<their kind>, which sets the tag.
+template <ASTKind K>
+struct ASTNode : AST {
+    static constexpr ASTKind Kind = K;
+protected:
+    ASTNode() : AST(K) {}
+};
+
+// Resolver slot of a local: declarations get one, references point at
+// the declaration they bind to, kNoSlot means "look the name up".
+constexpr int kNoSlot = -1;
+
+// Binary, Logical and Unary nodes.  A long operator chain nests one of
+// them per term, so passes walk these with an explicit stack instead of
+// recursing; only calls and indices recurse, and the parser caps those
+// at Parser::kMaxExprNesting.
+inline bool isOperatorNode(const AST* n) {
+    return n && (n->kind == ASTKind::Binary || n->kind == ASTKind::Logical ||
+                 n->kind == ASTKind::Unary);
+}
+
+// Checked downcast: the node as a T if its tag matches, else nullptr.
+template <typename T>
+inline T* ast_cast(AST* n) { return n && n->kind == T::Kind ? static_cast<T*>(n) : nullptr; }
+template <typename T>
+inline const T* ast_cast(const AST* n) { return n && n->kind == T::Kind ? static_cast<const T*>(n) : nullptr; }
 
 // ─────────────────────────────────────────────────────────────
 //  COMMENTS
 // ─────────────────────────────────────────────────────────────
 
-struct LineCommentAST : AST {
-    std::string text;
-    explicit LineCommentAST(std::string t) : text(std::move(t)) {}
+struct LineCommentAST : ASTNode<ASTKind::LineComment> {
+    std::string_view text;
+    explicit LineCommentAST(std::string_view t) : text(t) {}
     bool isNoOp() const override { return true; }
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "// " << text << "\n";
     }
 };
 
-struct BlockCommentAST : AST {
-    std::string text;
-    explicit BlockCommentAST(std::string t) : text(std::move(t)) {}
+struct BlockCommentAST : ASTNode<ASTKind::BlockComment> {
+    std::string_view text;
+    explicit BlockCommentAST(std::string_view t) : text(t) {}
     bool isNoOp() const override { return true; }
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "/* " << text << " */\n";
@@ -56,7 +143,7 @@ struct BlockCommentAST : AST {
 //  Literals
 // ─────────────────────────────────────────────────────────────
 
-struct NumberAST : AST {
+struct NumberAST : ASTNode<ASTKind::Number> {
     int val;
     explicit NumberAST(int v) : val(v) {}
     void print(int indent) const override {
@@ -64,7 +151,7 @@ struct NumberAST : AST {
     }
 };
 
-struct FloatAST : AST {
+struct FloatAST : ASTNode<ASTKind::Float> {
     double val;
     explicit FloatAST(double v) : val(v) {}
     void print(int indent) const override {
@@ -72,9 +159,10 @@ struct FloatAST : AST {
     }
 };
 
-struct VariableAST : AST {
-    std::string name;
-    explicit VariableAST(std::string n) : name(std::move(n)) {}
+struct VariableAST : ASTNode<ASTKind::Variable> {
+    Atom name;
+    int  slot = kNoSlot;
+    explicit VariableAST(Atom n) : name(n) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "Variable: " << name << "\n";
     }
@@ -84,38 +172,56 @@ struct VariableAST : AST {
 //  Expressions
 // ─────────────────────────────────────────────────────────────
 
-struct BinaryAST : AST {
-    std::string op;
-    std::unique_ptr<AST> lhs, rhs;
-    void print(int indent) const override {
-        std::cout << std::string(indent, ' ') << "BinaryOp: " << op << "\n";
-        lhs->print(indent + 4);
-        rhs->print(indent + 4);
-    }
-};
-
-struct LogicalAST : AST {
-    std::string op;
-    std::unique_ptr<AST> lhs, rhs;
-    void print(int indent) const override {
-        std::cout << std::string(indent, ' ') << "LogicalOp: " << op << "\n";
-        if (lhs) lhs->print(indent + 2);
-        if (rhs) rhs->print(indent + 2);
-    }
-};
-
-struct UnaryAST : AST {
-    std::string op;
-    std::unique_ptr<AST> operand;
-    void print(int indent) const override {
-        std::cout << std::string(indent, ' ') << "UnaryOp: " << op << "\n";
-        operand->print(indent + 4);
+// Operator nodes print through one loop, so a long chain dumps without
+// recursing once per term.
+inline void printOperatorTree(const AST* root, int indent);
+
+struct BinaryAST : ASTNode<ASTKind::Binary> {
+    BinOp op  = BinOp::Add;
+    AST*  lhs = nullptr;
+    AST*  rhs = nullptr;
+    void print(int indent) const override { printOperatorTree(this, indent); }
+};
+
+struct LogicalAST : ASTNode<ASTKind::Logical> {
+    BinOp op  = BinOp::Add;
+    AST*  lhs = nullptr;
+    AST*  rhs = nullptr;
+    void print(int indent) const override { printOperatorTree(this, indent); }
+};
+
+struct UnaryAST : ASTNode<ASTKind::Unary> {
+    UnOp op      = UnOp::Neg;
+    AST* operand = nullptr;
+    void print(int indent) const override { printOperatorTree(this, indent); }
+};
+
+inline void printOperatorTree(const AST* root, int indent) {
+    std::vector<std::pair<const AST*, int>> work{{root, indent}};
+    while (!work.empty()) {
+        auto [n, in] = work.back();
+        work.pop_back();
+        if (auto* b = ast_cast<BinaryAST>(n)) {
+            std::cout << std::string(in, ' ') << "BinaryOp: " << opSpelling(b->op) << "\n";
+            work.push_back({b->rhs, in + 4});
+            work.push_back({b->lhs, in + 4});
+        } else if (auto* l = ast_cast<LogicalAST>(n)) {
+            std::cout << std::string(in, ' ') << "LogicalOp: " << opSpelling(l->op) << "\n";
+            if (l->rhs) work.push_back({l->rhs, in + 2});
+            if (l->lhs) work.push_back({l->lhs, in + 2});
+        } else if (auto* u = ast_cast<UnaryAST>(n)) {
+            std::cout << std::string(in, ' ') << "UnaryOp: " << opSpelling(u->op) << "\n";
+            work.push_back({u->operand, in + 4});
+        } else {
+            n->print(in);
+        }
     }
-};
+}
 
-struct PostIncAST : AST {
-    std::string name;
-    explicit PostIncAST(std::string n) : name(std::move(n)) {}
+struct PostIncAST : ASTNode<ASTKind::PostInc> {
+    Atom name;
+    int  slot = kNoSlot;
+    explicit PostIncAST(Atom n) : name(n) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "PostIncrement: " << name << "++\n";
     }
@@ -125,19 +231,20 @@ struct PostIncAST : AST {
 //  Statements
 // ─────────────────────────────────────────────────────────────
 
-struct ReturnAST : AST {
-    std::unique_ptr<AST> expr;
-    explicit ReturnAST(std::unique_ptr<AST> e) : expr(std::move(e)) {}
+struct ReturnAST : ASTNode<ASTKind::Return> {
+    AST* expr;
+    explicit ReturnAST(AST* e) : expr(e) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "ReturnStmt\n";
         if (expr) expr->print(indent + 4);
     }
 };
 
-struct VarDeclAST : AST {
-    std::string name;
+struct VarDeclAST : ASTNode<ASTKind::VarDecl> {
+    Atom        name;
     ASTType     type;
-    explicit VarDeclAST(const std::string& n, ASTType t = ASTType::Int)
+    int         slot = kNoSlot;
+    explicit VarDeclAST(Atom n, ASTType t = ASTType::Int)
         : name(n), type(t) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
@@ -145,11 +252,12 @@ struct VarDeclAST : AST {
     }
 };
 
-struct AssignAST : AST {
-    std::string name;
-    std::unique_ptr<AST> expr;
-    AssignAST(std::string n, std::unique_ptr<AST> v)
-        : name(std::move(n)), expr(std::move(v)) {}
+struct AssignAST : ASTNode<ASTKind::Assign> {
+    Atom name;
+    AST* expr;
+    int  slot = kNoSlot;
+    AssignAST(Atom n, AST* v)
+        : name(n), expr(v) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "Assignment: " << name << " =\n";
         if (expr) expr->print(indent + 4);
@@ -160,12 +268,13 @@ struct AssignAST : AST {
 // Replaces the old pattern of wrapping VarDecl+Assign in a BlockAST,
 // which erroneously destroyed the variable at the end of the inner block.
 // Example:  int result = obj.method();
-struct VarDeclInitAST : AST {
-    std::string          name;
-    ASTType              type;
-    std::unique_ptr<AST> init;
-    VarDeclInitAST(const std::string& n, ASTType t, std::unique_ptr<AST> e)
-        : name(n), type(t), init(std::move(e)) {}
+struct VarDeclInitAST : ASTNode<ASTKind::VarDeclInit> {
+    Atom    name;
+    ASTType type;
+    AST*    init;
+    int     slot = kNoSlot;
+    VarDeclInitAST(Atom n, ASTType t, AST* e)
+        : name(n), type(t), init(e) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "VarDeclInit: " << astTypeName(type) << " " << name << " =\n";
@@ -173,16 +282,18 @@ struct VarDeclInitAST : AST {
     }
 };
 
-struct BlockAST : AST {
-    std::vector<std::unique_ptr<AST>> statements;
+struct BlockAST : ASTNode<ASTKind::Block> {
+    ArenaList<AST*> statements;
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "Block:\n";
         for (const auto& stmt : statements) stmt->print(indent + 2);
     }
 };
 
-struct IfAST : AST {
-    std::unique_ptr<AST> cond, thenBlock, elseBlock;
+struct IfAST : ASTNode<ASTKind::If> {
+    AST* cond      = nullptr;
+    AST* thenBlock = nullptr;
+    AST* elseBlock = nullptr;
     void print(int indent) const override {
         std::string sp(indent, ' ');
         std::cout << sp << "IfStatement\n" << sp << "  Condition:\n";
@@ -196,8 +307,9 @@ struct IfAST : AST {
     }
 };
 
-struct WhileAST : AST {
-    std::unique_ptr<AST> cond, body;
+struct WhileAST : ASTNode<ASTKind::While> {
+    AST* cond = nullptr;
+    AST* body = nullptr;
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "WhileLoop\n";
         if (cond) cond->print(indent + 2);
@@ -205,12 +317,13 @@ struct WhileAST : AST {
     }
 };
 
-struct ForAST : AST {
-    std::unique_ptr<AST> init, cond, inc, body;
-    ForAST(std::unique_ptr<AST> i, std::unique_ptr<AST> c,
-           std::unique_ptr<AST> in, std::unique_ptr<BlockAST> b)
-        : init(std::move(i)), cond(std::move(c)),
-          inc(std::move(in)), body(std::move(b)) {}
+struct ForAST : ASTNode<ASTKind::For> {
+    AST* init;
+    AST* cond;
+    AST* inc;
+    AST* body;
+    ForAST(AST* i, AST* c, AST* in, BlockAST* b)
+        : init(i), cond(c), inc(in), body(b) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "ForLoop\n";
         if (init) init->print(indent + 2);
@@ -220,13 +333,13 @@ struct ForAST : AST {
     }
 };
 
-struct BreakAST : AST {
+struct BreakAST : ASTNode<ASTKind::Break> {
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "Break\n";
     }
 };
 
-struct ContinueAST : AST {
+struct ContinueAST : ASTNode<ASTKind::Continue> {
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "Continue\n";
     }
@@ -236,11 +349,12 @@ struct ContinueAST : AST {
 //  Arrays
 // ─────────────────────────────────────────────────────────────
 
-struct ArrayDeclAST : AST {
-    std::string name;
+struct ArrayDeclAST : ASTNode<ASTKind::ArrayDecl> {
+    Atom        name;
     int         size;
     ASTType     type;
-    ArrayDeclAST(const std::string& n, int s, ASTType t = ASTType::Int)
+    int         slot = kNoSlot;
+    ArrayDeclAST(Atom n, int s, ASTType t = ASTType::Int)
         : name(n), size(s), type(t) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
@@ -249,24 +363,25 @@ struct ArrayDeclAST : AST {
     }
 };
 
-struct ArrayAccessAST : AST {
-    std::string name;
-    std::unique_ptr<AST> index;
-    ArrayAccessAST(const std::string& n, std::unique_ptr<AST> idx)
-        : name(n), index(std::move(idx)) {}
+struct ArrayAccessAST : ASTNode<ASTKind::ArrayAccess> {
+    Atom name;
+    AST* index;
+    int  slot = kNoSlot;
+    ArrayAccessAST(Atom n, AST* idx)
+        : name(n), index(idx) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "ArrayAccess: " << name << "\n";
         index->print(indent + 4);
     }
 };
 
-struct ArrayAssignAST : AST {
-    std::string name;
-    std::unique_ptr<AST> index, expr;
-    ArrayAssignAST(const std::string& n,
-                   std::unique_ptr<AST> idx,
-                   std::unique_ptr<AST> e)
-        : name(n), index(std::move(idx)), expr(std::move(e)) {}
+struct ArrayAssignAST : ASTNode<ASTKind::ArrayAssign> {
+    Atom name;
+    AST* index;
+    AST* expr;
+    int  slot = kNoSlot;
+    ArrayAssignAST(Atom n, AST* idx, AST* e)
+        : name(n), index(idx), expr(e) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "ArrayAssign: " << name << "[...] =\n";
@@ -279,14 +394,15 @@ struct ArrayAssignAST : AST {
 //  Functions
 // ─────────────────────────────────────────────────────────────
 
-struct PrototypeAST : AST {
-    std::string              name;
-    std::vector<std::string> args;
-    std::vector<ASTType>     argTypes;
-    ASTType                  returnType = ASTType::Int;
+struct PrototypeAST : ASTNode<ASTKind::Prototype> {
+    Atom               name;
+    ArenaList<Atom>    args;
+    ArenaList<ASTType> argTypes;
+    ASTType            returnType = ASTType::Int;
+    bool               fast       = false;   // 'fast' modifier: fast-math body
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
-                  << "FunctionPrototype: "
+                  << "FunctionPrototype: " << (fast ? "fast " : "")
                   << astTypeName(returnType) << " " << name << "(";
         for (size_t i = 0; i < args.size(); ++i) {
             if (i) std::cout << ", ";
@@ -297,11 +413,13 @@ struct PrototypeAST : AST {
     }
 };
 
-struct FunctionAST : AST {
-    std::unique_ptr<PrototypeAST> proto;
-    std::unique_ptr<BlockAST>     body;
-    FunctionAST(std::unique_ptr<PrototypeAST> p, std::unique_ptr<BlockAST> b)
-        : proto(std::move(p)), body(std::move(b)) {}
+// Parameters take slots 0..args-1; locals follow.
+struct FunctionAST : ASTNode<ASTKind::Function> {
+    PrototypeAST* proto;
+    BlockAST*     body;
+    int           slotCount = 0;   // set by the Resolver
+    FunctionAST(PrototypeAST* p, BlockAST* b)
+        : proto(p), body(b) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ') << "FunctionDefinition\n";
         if (proto) proto->print(indent + 2);
@@ -309,9 +427,9 @@ struct FunctionAST : AST {
     }
 };
 
-struct CallAST : AST {
-    std::string callee;
-    std::vector<std::unique_ptr<AST>> args;
+struct CallAST : ASTNode<ASTKind::Call> {
+    Atom            callee;
+    ArenaList<AST*> args;
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "FunctionCall: " << callee << "\n";
@@ -325,15 +443,15 @@ struct CallAST : AST {
 
 // A single field inside a class body
 struct ClassField {
-    std::string name;
+    Atom        name;
     ASTType     type;
 };
 
 // class Foo { int x; float y; int getX() { ... } }
-struct ClassDeclAST : AST {
-    std::string                               name;
-    std::vector<ClassField>                   fields;
-    std::vector<std::unique_ptr<FunctionAST>> methods;
+struct ClassDeclAST : ASTNode<ASTKind::ClassDecl> {
+    Atom                    name;
+    ArenaList<ClassField>   fields;
+    ArenaList<FunctionAST*> methods;
 
     void print(int indent) const override {
         std::string sp(indent, ' ');
@@ -348,10 +466,11 @@ struct ClassDeclAST : AST {
 // ─────────────────────────────────────────────────────────────
 //  OOP — Object declaration  (ClassName varName;)
 // ─────────────────────────────────────────────────────────────
-struct ObjectDeclAST : AST {
-    std::string className;
-    std::string varName;
-    ObjectDeclAST(const std::string& cn, const std::string& vn)
+struct ObjectDeclAST : ASTNode<ASTKind::ObjectDecl> {
+    Atom className;
+    Atom varName;
+    int  slot = kNoSlot;
+    ObjectDeclAST(Atom cn, Atom vn)
         : className(cn), varName(vn) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
@@ -362,10 +481,11 @@ struct ObjectDeclAST : AST {
 // ─────────────────────────────────────────────────────────────
 //  OOP — Member access  (obj.field  in expression)
 // ─────────────────────────────────────────────────────────────
-struct MemberAccessAST : AST {
-    std::string objName;
-    std::string memberName;
-    MemberAccessAST(const std::string& obj, const std::string& mem)
+struct MemberAccessAST : ASTNode<ASTKind::MemberAccess> {
+    Atom objName;
+    Atom memberName;
+    int  slot = kNoSlot;
+    MemberAccessAST(Atom obj, Atom mem)
         : objName(obj), memberName(mem) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
@@ -376,13 +496,13 @@ struct MemberAccessAST : AST {
 // ─────────────────────────────────────────────────────────────
 //  OOP — Member assign  (obj.field = expr;)
 // ─────────────────────────────────────────────────────────────
-struct MemberAssignAST : AST {
-    std::string          objName;
-    std::string          memberName;
-    std::unique_ptr<AST> expr;
-    MemberAssignAST(const std::string& obj, const std::string& mem,
-                    std::unique_ptr<AST> e)
-        : objName(obj), memberName(mem), expr(std::move(e)) {}
+struct MemberAssignAST : ASTNode<ASTKind::MemberAssign> {
+    Atom objName;
+    Atom memberName;
+    AST* expr;
+    int  slot = kNoSlot;
+    MemberAssignAST(Atom obj, Atom mem, AST* e)
+        : objName(obj), memberName(mem), expr(e) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "MemberAssign: " << objName << "." << memberName << " =\n";
@@ -392,15 +512,17 @@ struct MemberAssignAST : AST {
 
 // ─────────────────────────────────────────────────────────────
 //  OOP — Method call  (obj.method(args)  or  this.method(args))
-//         objName == "this" → call on implicit this pointer
+//         objName == thisAtom() → call on implicit this pointer
 // ─────────────────────────────────────────────────────────────
-struct MethodCallAST : AST {
-    std::string                       objName;
-    std::string                       methodName;
-    std::vector<std::unique_ptr<AST>> args;
-    MethodCallAST(const std::string& obj, const std::string& meth,
-                  std::vector<std::unique_ptr<AST>> a)
-        : objName(obj), methodName(meth), args(std::move(a)) {}
+inline Atom thisAtom() { return Atom::wellKnown(Atom::This); }
+
+struct MethodCallAST : ASTNode<ASTKind::MethodCall> {
+    Atom            objName;
+    Atom            methodName;
+    ArenaList<AST*> args;
+    int             slot = kNoSlot;
+    MethodCallAST(Atom obj, Atom meth, ArenaList<AST*> a)
+        : objName(obj), methodName(meth), args(a) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "MethodCall: " << objName << "." << methodName << "()\n";
@@ -411,9 +533,9 @@ struct MethodCallAST : AST {
 // ─────────────────────────────────────────────────────────────
 //  OOP — this.field access (inside a method)
 // ─────────────────────────────────────────────────────────────
-struct ThisAccessAST : AST {
-    std::string memberName;
-    explicit ThisAccessAST(const std::string& m) : memberName(m) {}
+struct ThisAccessAST : ASTNode<ASTKind::ThisAccess> {
+    Atom memberName;
+    explicit ThisAccessAST(Atom m) : memberName(m) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "ThisAccess: this." << memberName << "\n";
@@ -423,11 +545,11 @@ struct ThisAccessAST : AST {
 // ─────────────────────────────────────────────────────────────
 //  OOP — this.field = expr (inside a method)
 // ─────────────────────────────────────────────────────────────
-struct ThisAssignAST : AST {
-    std::string          memberName;
-    std::unique_ptr<AST> expr;
-    ThisAssignAST(const std::string& m, std::unique_ptr<AST> e)
-        : memberName(m), expr(std::move(e)) {}
+struct ThisAssignAST : ASTNode<ASTKind::ThisAssign> {
+    Atom memberName;
+    AST* expr;
+    ThisAssignAST(Atom m, AST* e)
+        : memberName(m), expr(e) {}
     void print(int indent) const override {
         std::cout << std::string(indent, ' ')
                   << "ThisAssign: this." << memberName << " =\n";
@@ -436,10 +558,13 @@ struct ThisAssignAST : AST {
 };
 
 // ─────────────────────────────────────────────────────────────
-//  Program root
+//  Program root — the only heap-allocated node.  Owns the arena
+//  every other node lives in; destroying it frees the whole tree
+//  in one step.
 // ─────────────────────────────────────────────────────────────
-struct ProgramAST : AST {
-    std::vector<std::unique_ptr<AST>> topLevel;
+struct ProgramAST final : ASTNode<ASTKind::Program> {
+    ASTArena        arena;
+    ArenaList<AST*> topLevel;
     void print(int indent) const override {
         std::cout << "--- [SYNTACTIC VALIDATION: AST TREE] ---\n";
         for (const auto& e : topLevel) e->print(indent);
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ── Arena-backed child list ───────────────────────────────────
+// A fixed-size array living in an ASTArena: pointer + count, built once
+// by the parser and read-only afterwards.
+template <typename T>
+class ArenaList {
+public:
+    ArenaList() = default;
+    ArenaList(T* items, size_t n) : items(items), count((uint32_t)n) {}
+
+    T*     begin()  const { return items; }
+    T*     end()    const { return items + count; }
+    size_t size()   const { return count; }
+    bool   empty()  const { return count == 0; }
+    T&     operator[](size_t i) const { return items[i]; }
+
+private:
+    T*       items = nullptr;
+    uint32_t count = 0;
+};
+
+// ── Bump-pointer arena for the AST ────────────────────────────
+//
+// Nodes, child lists and comment text are carved out of 64 KiB blocks.
+// Nothing allocated here is ever destroyed individually: dropping the
+// arena frees the blocks and with them the whole tree, so every type
+// make() builds must be trivially destructible (checked at compile time).
+class ASTArena {
+public:
+    ASTArena() = default;
+    ASTArena(const ASTArena&)            = delete;
+    ASTArena& operator=(const ASTArena&) = delete;
+
+    void* allocate(size_t size, size_t align) {
+        uintptr_t p = ((uintptr_t)cur + (align - 1)) & ~(uintptr_t)(align - 1);
+        if (p + size > (uintptr_t)end) return allocateSlow(size, align);
+        cur = (char*)(p + size);
+        return (void*)p;
+    }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena objects are released without running destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    ArenaList<T> list(const T* first, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "arena lists are memcpy'd");
+        if (n == 0) return {};
+        T* items = static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+        std::memcpy(items, first, n * sizeof(T));
+        return {items, n};
+    }
+
+    template <typename T>
+    ArenaList<T> list(const std::vector<T>& v) { return list(v.data(), v.size()); }
+
+    std::string_view copy(std::string_view s) {
+        if (s.empty()) return {};
+        char* p = static_cast<char*>(allocate(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+
+    // Takes over another arena's blocks, and with them everything
+    // allocated there; 'other' is left empty.
+    void adopt(ASTArena& other);
+
+    size_t bytesReserved() const { return reserved; }
+
+private:
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    char*                                cur = nullptr;
+    char*                                end = nullptr;
+    size_t                               reserved = 0;
+    std::vector<std::unique_ptr<char[]>> blocks;
+
+    void* allocateSlow(size_t size, size_t align);
+};
@@ -1,9 +1,9 @@
 #pragma once
-#include "lexer/Token.h"
+#include "lexer/TokenStream.h"
 #include "AST.h"
 #include <vector>
 #include <string>
-#include <set>
+#include <unordered_set>
 
 struct ParseError {
     int         line;
@@ -12,40 +12,98 @@ struct ParseError {
 
 class Parser {
 public:
-    explicit Parser(const std::vector<Token>& t);
-    std::unique_ptr<AST> parse();
+    // Reads the token arrays in 'tokens', which must outlive the parser.
+    // With threads > 1, large programs have their top-level functions and
+    // classes parsed concurrently; the result is the same either way.
+    explicit Parser(const TokenStream& tokens, unsigned threads = 1);
+    std::unique_ptr<ProgramAST> parse();
 
     bool hasErrors() const { return !errors.empty(); }
     const std::vector<ParseError>& getErrors() const { return errors; }
 
+    // Below this many tokens the pre-scan and threads cost more than
+    // they save, and parse() stays on the calling thread.
+    static constexpr size_t kMinParallelTokens = 8192;
+
+    // How deeply expressions may nest through call arguments and indices,
+    // the only nesting the later passes still recurse through.
+    static constexpr int kMaxExprNesting = 1000;
+
 private:
-    const std::vector<Token>& tokens;
-    size_t pos;
+    const TokenStream&      tokens;
+    unsigned                threads = 1;
+    size_t                  pos = 0;
     std::vector<ParseError> errors;
+    ASTArena*               arena = nullptr;   // the ProgramAST's, during parse()
+    std::vector<AST*>       pending;           // list items not yet copied into the arena
+
+    // Expression parser state: frames of the expressions being parsed
+    // (nested parses stack above their parent's), and how deeply
+    // expression() itself is nested through call arguments and indices.
+    struct ExprFrame {
+        enum Kind : uint8_t { Expr, Paren, Unary };
+        Kind  kind;
+        UnOp  unOp    = UnOp::Neg;     // Unary
+        BinOp op      = BinOp::Add;    // Expr: operator awaiting its right operand
+        int   minPrec = 0;             // Expr
+        AST*  lhs     = nullptr;       // Expr: operand so far
+
+        static ExprFrame expr(int minPrec) { ExprFrame f{Expr}; f.minPrec = minPrec; return f; }
+        static ExprFrame paren()           { return ExprFrame{Paren}; }
+        static ExprFrame unary(UnOp op)    { ExprFrame f{Unary}; f.unOp = op; return f; }
+    };
+    std::vector<ExprFrame> exprFrames;
+    int                    exprNesting = 0;
 
-    // Known class names (populated as class declarations are parsed)
-    std::set<std::string> classNames;
+    // Known class names (populated as class declarations are parsed), and
+    // every name parseClass registered, in order.
+    std::unordered_set<Atom> classNames;
+    std::vector<Atom>        classOrder;
+
+    // ── parallel top level ────────────────────────────────────
+    struct Piece;
+    size_t parseParallel(ProgramAST& program);
+    void   parsePiece(Piece& piece, const std::vector<Atom>& predicted) const;
+
+    // ── token cursor ──────────────────────────────────────────
+    Token        peek(size_t k = 0) const { return tokens.at(pos + k); }
+    TokenType    peekType(size_t k = 0) const { return tokens.type(pos + k); }
+    bool         check(TokenType t, size_t k = 0) const { return tokens.type(pos + k) == t; }
+    bool         match(TokenType t);
+    Token        advance();
 
     // ── helpers ───────────────────────────────────────────────
     void addError(const std::string& msg);
+    void addError(int line, const std::string& msg);
     int  currentLine() const;
     void syncStatement();
     void syncFunction();
 
-    std::vector<std::unique_ptr<AST>> drainComments();
+    // ── arena ─────────────────────────────────────────────────
+    template <typename T, typename... Args>
+    T* make(Args&&... args) { return arena->make<T>(std::forward<Args>(args)...); }
+
+    // Lists are collected on 'pending' (nested lists stack above their
+    // parent's items) and copied into the arena once complete.
+    ArenaList<AST*> takePending(size_t mark);
+
+    void drainComments();   // appends comment nodes to 'pending'
+    AST* comment(const Token& tok);
 
     // ── grammar ───────────────────────────────────────────────
-    std::unique_ptr<AST>         statement();
-    std::unique_ptr<AST>         expression();
-    std::unique_ptr<AST>         primary();
-    std::unique_ptr<BlockAST>    block();
-    std::unique_ptr<FunctionAST> function();
-    std::unique_ptr<ClassDeclAST> parseClass();   // NEW: class definition
-    std::unique_ptr<AST>         parseExpression(int minPrec = 0);
+    void                         topLevel(size_t end);
+    AST*                         statement();
+    AST*                         expression();
+    AST*                         operand();
+    BlockAST*                    block();
+    FunctionAST*                 function();
+    ClassDeclAST*                parseClass();   // NEW: class definition
+    void                         skipNestedExpression();
     int                          getPrecedence(TokenType type);
     bool                         isComment(TokenType t) const;
     bool                         isTypeKeyword(TokenType t) const;
+    bool                         isFastModifier(size_t k = 0) const;
 
     // ── OOP argument list parser (shared by call / method call) ──
-    std::vector<std::unique_ptr<AST>> parseArgList();
+    ArenaList<AST*> parseArgList();
 };
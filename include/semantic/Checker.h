@@ -0,0 +1,98 @@
+#pragma once
+#include "parser/AST.h"
+#include "semantic/SymbolTable.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SemanticError {
+    std::string message;
+};
+
+// ── Semantic checker ──────────────────────────────────────────
+//
+// Walks the AST exactly as CodeGen does (same scopes, same order of
+// definitions, same early exits) but builds no IR, so a program can be
+// checked without an LLVMContext.  It is the only source of semantic
+// errors: undeclared names, unknown classes, fields and methods, arity,
+// redeclarations and misplaced 'this', break and continue, and what
+// would otherwise reach the IR verifier or crash CodeGen (void
+// variables, arrays, parameters and fields, void operands, values
+// returned from void functions, assignment to or increment of arrays,
+// functions and objects).  CodeGen runs only on programs it accepts.
+//
+// Names come from the Resolver, which must have run first: a reference's
+// slot is the declaration it names, whatever that declaration's kind,
+// and a declaration without a slot redeclares a name in its scope.
+class Checker {
+public:
+    void check(const ProgramAST& program);
+
+    bool hasErrors() const { return !errors.empty(); }
+    const std::vector<SemanticError>& getErrors() const { return errors; }
+
+private:
+    // The LLVM type CodeGen would give a value; None where its
+    // generate() returns null.  Ptr is only the implicit 'this'.
+    enum class Ty : uint8_t { None, Bool, Int, Float, Void, Ptr };
+
+    struct Signature {
+        Ty              ret = Ty::Int;
+        std::vector<Ty> params;
+    };
+    struct Class {
+        std::vector<std::pair<Atom, ValueType>> fields;
+        std::unordered_map<Atom, Signature>     methods;   // known once generated
+
+        const std::pair<Atom, ValueType>* field(Atom name) const {
+            for (auto& f : fields)
+                if (f.first == name) return &f;
+            return nullptr;
+        }
+    };
+
+    // What the current function's declarations put in each slot.
+    struct Local {
+        SymbolKind kind = SymbolKind::Variable;
+        ValueType  type = ValueType::Int;
+        Atom       objectClass;    // kind == Object
+    };
+
+    std::vector<Local>                   locals;
+    std::unordered_map<Atom, Class>      classes;
+    std::unordered_map<Atom, Signature>  functions;   // callable name → signature
+    std::vector<SemanticError>           errors;
+
+    // ── Current function ──────────────────────────────────────
+    Atom currentFunction;       // its call name
+    Atom currentClass;          // non-empty inside a class's methods
+    bool inMethod   = false;
+    Ty   returnTy   = Ty::Int;
+    int  loopDepth  = 0;
+    bool terminated = false;    // CodeGen's insert block has a terminator
+
+    void addError(const std::string& msg);
+
+    static Ty typeOf(ASTType t);
+    static Ty typeOf(ValueType t);
+    static Ty storedAs(ValueType t);   // a load from a slot of type t
+    static Signature signatureOf(const PrototypeAST* proto, bool method);
+
+    Ty   coerce(Ty val, Ty target);
+    Ty   toBool(Ty val);
+    void declare(int slot, SymbolKind kind, ValueType type, Atom objectClass = Atom());
+    const Local* lookup(Atom name, int slot) const;
+    void enterFunction(const FunctionAST* f, Atom callName);
+    void method(const FunctionAST* f, Atom className);
+    Ty   visit(const AST* node);
+
+    // Operator trees are checked by operators() on these stacks, in
+    // visit()'s order; a nested call resumes above its caller's entries.
+    // Stage 0 expands a node, 1 has its first operand's type on opValues,
+    // 2 (&&, || only) its second.
+    struct OpFrame { const AST* node; uint8_t stage; };
+    std::vector<OpFrame> opFrames;
+    std::vector<Ty>      opValues;
+    Ty   operators(const AST* root);
+};
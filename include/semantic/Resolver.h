@@ -0,0 +1,53 @@
+#pragma once
+#include "parser/AST.h"
+#include "semantic/SymbolTable.h"
+#include <unordered_map>
+#include <vector>
+
+// ── Name resolution ───────────────────────────────────────────
+//
+// Runs between the parser and CodeGen and turns the parse tree into a
+// typed AST: every local declaration gets a per-function slot, every
+// reference to a local is bound to the slot of the declaration it names,
+// and every expression node records its ValueType.
+//
+// Names live in the compiler's one SymbolTable, scoped as the language
+// is (a parameter scope, then one scope per block; a rejected
+// redeclaration declares nothing), each local Symbol carrying its slot.
+// A reference to a local is bound whatever the local's kind, so the
+// Checker can tell a wrong kind from an undeclared name; only functions
+// and undeclared names stay unbound.  The symbol dump is this table's
+// log.  The pass never fails.
+class Resolver {
+public:
+    // With 'logSymbols', every declaration is recorded for the symbol dump.
+    explicit Resolver(bool logSymbols = false) { symbols.setLogging(logSymbols); }
+
+    void resolve(ProgramAST& program);
+
+    const std::vector<SymbolLogEntry>& getSymbolLog() const { return symbols.getLog(); }
+
+private:
+    // Functions and methods (by call name) are visible to calls once
+    // defined, like CodeGen's function map.
+    SymbolTable                                   symbols;
+    int                                           nextSlot = 0;
+    std::unordered_map<Atom, const ClassDeclAST*> classes;
+    const ClassDeclAST*                           currentClass = nullptr;
+
+    int declare(Atom name, SymbolKind kind, ValueType type, int arraySize = 0,
+                Atom objectClass = Atom());
+
+    // ── walk ──────────────────────────────────────────────────
+    // Operator trees go through operators() on these stacks; a nested
+    // call resumes above its caller's entries.
+    struct OpFrame { AST* node; bool expanded; };
+    std::vector<OpFrame>   opFrames;
+    std::vector<ValueType> opValues;
+
+    void      function(FunctionAST* f, Atom callName);
+    ValueType visit(AST* node);
+    ValueType operators(AST* root);
+    ValueType fieldType(const ClassDeclAST* cls, Atom field) const;
+    ValueType methodType(const ClassDeclAST* cls, Atom method) const;
+};
@@ -1,10 +1,11 @@
 #pragma once
+#include "semantic/ValueType.h"
+#include "utils/Atom.h"
+#include <cstdint>
+#include <deque>
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include <stdexcept>
-#include <llvm/IR/Value.h>
-#include <llvm/IR/Type.h>
 
 // ── Symbol kinds ──────────────────────────────────────────────
 enum class SymbolKind {
@@ -15,24 +16,16 @@ enum class SymbolKind {
     Object       // class instance (stack-allocated struct)
 };
 
-// ── Value types ───────────────────────────────────────────────
-enum class ValueType {
-    Int,
-    Float,
-    Void,
-    Unknown
-};
-
 // ── A single symbol entry ─────────────────────────────────────
 struct Symbol {
-    std::string  name;
+    Atom         name;
     SymbolKind   kind;
     ValueType    type;
-    llvm::Value* value;
     int          arraySize      = 0;
     int          definedAtDepth = 0;
-    std::string  ownerFunction;
-    std::string  objectClass;    // for kind==Object: the class name
+    Atom         ownerFunction;
+    Atom         objectClass;    // for kind==Object: the class name
+    int          slot           = -1;   // the Resolver's per-function local slot
 
     std::vector<ValueType> paramTypes;
     ValueType              returnType = ValueType::Int;
@@ -40,19 +33,27 @@ struct Symbol {
 
 // ── Flat log entry ────────────────────────────────────────────
 struct SymbolLogEntry {
-    std::string  name;
+    Atom         name;
     SymbolKind   kind;
     ValueType    type;
     int          arraySize      = 0;
     int          scopeDepth     = 0;
-    std::string  ownerFunction;
-    std::string  objectClass;    // for kind==Object
+    Atom         ownerFunction;
+    Atom         objectClass;    // for kind==Object
 
     std::vector<ValueType> paramTypes;
     ValueType              returnType = ValueType::Int;
 };
 
 // ── Scoped symbol table ────────────────────────────────────────
+//
+// One open-addressing table maps each name to its innermost binding;
+// every binding links to the one it shadows.  Local bindings live on a
+// stack and entering a scope just records the stack height, so leaving
+// it pops back to that mark and re-exposes each popped name's shadowed
+// binding.  Lookup is one probe at any nesting depth.  Symbols never
+// move while they are in scope, so returned pointers stay valid until
+// their scope is exited.
 class SymbolTable {
 public:
     SymbolTable();
@@ -60,49 +61,66 @@ public:
     // ── Scope management ──────────────────────────────────────
     void enterScope();
     void exitScope();
-    int  currentDepth() const { return (int)scopes.size() - 1; }
+    int  currentDepth() const { return (int)scopeMarks.size() - 1; }
 
-    void setCurrentFunction(const std::string& fn) { currentFunction = fn; }
-    void clearCurrentFunction()                     { currentFunction.clear(); }
-    const std::string& getCurrentFunction() const   { return currentFunction; }
+    void setCurrentFunction(Atom fn)      { currentFunction = fn; }
+    void clearCurrentFunction()           { currentFunction = Atom(); }
+    Atom getCurrentFunction() const       { return currentFunction; }
 
     // ── Insertion ─────────────────────────────────────────────
-    void insert(const std::string& name,
+    void insert(Atom               name,
                 ValueType          type,
                 SymbolKind         kind,
-                llvm::Value*       value,
                 int                arraySize   = 0,
-                const std::string& objectClass = "");
+                Atom               objectClass = Atom(),
+                int                localSlot   = -1);
 
-    void insertFunction(const std::string&            name,
+    void insertFunction(Atom                          name,
                         ValueType                     returnType,
-                        const std::vector<ValueType>& paramTypes,
-                        llvm::Value*                  value = nullptr);
+                        const std::vector<ValueType>& paramTypes);
 
     // ── Lookup ────────────────────────────────────────────────
-    const Symbol* lookup(const std::string& name) const;
-    Symbol*       lookup(const std::string& name);
-    const Symbol* lookupCurrentScope(const std::string& name) const;
-    llvm::Value*  lookupValue(const std::string& name) const;
-    ValueType     lookupType(const std::string& name) const;
+    const Symbol* lookup(Atom name) const;
+    Symbol*       lookup(Atom name);
+    const Symbol* lookupCurrentScope(Atom name) const;
+    const Symbol* lookupFunction(Atom name) const;   // ignores locals shadowing it
+    ValueType     lookupType(Atom name) const;
 
     // ── Utilities ─────────────────────────────────────────────
-    bool isDeclared(const std::string& name) const { return lookup(name) != nullptr; }
-    bool isDeclaredInCurrentScope(const std::string& name) const {
+    bool isDeclared(Atom name) const { return lookup(name) != nullptr; }
+    bool isDeclaredInCurrentScope(Atom name) const {
         return lookupCurrentScope(name) != nullptr;
     }
-    void updateValue(const std::string& name, llvm::Value* value);
 
     static std::string typeName(ValueType t);
     static std::string kindName(SymbolKind k);
 
+    // Every insertion is copied to the log unless logging is off.
     const std::vector<SymbolLogEntry>& getLog() const { return log; }
+    void setLogging(bool on) { logging = on; }
 
 private:
-    using Scope = std::unordered_map<std::string, Symbol>;
-    std::vector<Scope>         scopes;
+    struct Binding {
+        Symbol   sym;
+        Binding* shadowed = nullptr;    // same name, outer scope
+    };
+    struct Slot {
+        uint32_t key = 0;               // atom id + 1; 0 = empty
+        Binding* top = nullptr;         // null once all its scopes closed
+    };
+
+    std::deque<Binding>         globals;      // depth 0, never removed
+    std::deque<Binding>         locals;       // innermost last
+    std::vector<size_t>         scopeMarks;   // locals.size() at each enterScope
+    std::vector<Slot>           slots;        // power-of-two size, linear probing
+    size_t                      used = 0;
     std::vector<SymbolLogEntry> log;
-    std::string                currentFunction;
-
-    void appendLog(const Symbol& sym);
+    bool                        logging = true;
+    Atom                        currentFunction;
+
+    Slot&       slot(Atom name);              // finds or claims
+    const Slot* findSlot(Atom name) const;
+    void        grow();
+    void        bind(Slot& s, const Symbol& sym);
+    void        appendLog(const Symbol& sym);
 };
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+// ── Value types ───────────────────────────────────────────────
+// Shared by the symbol table and the resolver's expression types.
+enum class ValueType : uint8_t {
+    Int,
+    Float,
+    Void,
+    Unknown
+};
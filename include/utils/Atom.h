@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class AtomTable;
+
+// ── Interned identifiers ──────────────────────────────────────
+//
+// An Atom is a handle to the single copy of a string in one compile's
+// AtomTable.  The lexer interns every identifier as it scans it; from
+// then on names are stored, compared (pointer ==) and hashed (dense
+// integer id) as Atoms, and only turned back into text for IR value
+// names and diagnostics.  Atoms from different tables never compare
+// equal, except the well-known ones, which every table shares.
+class Atom {
+public:
+    struct Entry {
+        std::string text;
+        uint32_t    id;
+    };
+
+    // Names the compiler itself looks for.  Static, so they may be held
+    // anywhere and used from any thread.
+    enum WellKnown : uint32_t { This, Fast, kWellKnownCount };
+
+    Atom() = default;                              // the empty string
+    static Atom intern(std::string_view text);     // into the thread's current table
+    static Atom wellKnown(WellKnown w) { return Atom(&kWellKnown[w]); }
+
+    const std::string& str()   const { return entry ? entry->text : kEmpty; }
+    uint32_t           id()    const { return entry ? entry->id : 0; }   // 0 = empty
+    bool               empty() const { return entry == nullptr; }
+
+    bool operator==(Atom o) const { return entry == o.entry; }
+    bool operator!=(Atom o) const { return entry != o.entry; }
+
+private:
+    friend class AtomTable;
+
+    const Entry* entry = nullptr;
+    explicit Atom(const Entry* e) : entry(e) {}
+
+    static const Entry kWellKnown[kWellKnownCount];
+    inline static const std::string kEmpty;
+};
+
+// ── Per-compile intern table ──────────────────────────────────
+//
+// Owns the atoms of one compile and frees them with it.  Atom::intern()
+// goes to the calling thread's current table, installed by a Scope; a
+// thread without one interns into a table of its own that lives as long
+// as the thread.  There is no lock: one thread at a time interns into a
+// table (the lexer, then resolver, checker and code generator; parser
+// workers only read atoms off the tokens).
+class AtomTable {
+public:
+    AtomTable();
+    AtomTable(const AtomTable&) = delete;
+    AtomTable& operator=(const AtomTable&) = delete;
+
+    Atom intern(std::string_view text);
+
+    // Makes 'table' the thread's current one until end() or destruction,
+    // then restores the previous one.  Scopes nest.
+    class Scope {
+    public:
+        explicit Scope(AtomTable& table);
+        ~Scope() { end(); }
+        void end();
+    private:
+        AtomTable* prev;
+        bool       active = true;
+    };
+
+private:
+    friend class Atom;
+
+    std::deque<Atom::Entry>                                  entries;   // stable addresses
+    std::unordered_map<std::string_view, const Atom::Entry*> index;     // views into entries
+
+    static AtomTable*& current();
+};
+
+namespace std {
+template <> struct hash<Atom> {
+    size_t operator()(Atom a) const noexcept { return a.id(); }
+};
+} // namespace std
+
+std::ostream& operator<<(std::ostream& os, Atom a);
+
+// Diagnostics splice names into messages: "'" + name + "' ..."
+inline std::string operator+(const char* s, Atom a)        { return s + a.str(); }
+inline std::string operator+(const std::string& s, Atom a) { return s + a.str(); }
+inline std::string operator+(std::string&& s, Atom a)      { s += a.str(); return std::move(s); }
+inline std::string operator+(Atom a, const char* s)        { return a.str() + s; }
+inline std::string operator+(Atom a, const std::string& s) { return a.str() + s; }
@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ── Read-only source text shared by every compile pass ────────
+//
+// A file is mmap'ed once (falling back to a plain read for anything
+// that cannot be mapped) and every consumer — both lexer passes, the
+// token views they hand out, error reporting and the auto-corrector —
+// works on view() instead of its own copy.  The buffer must outlive
+// all tokens lexed from it.
+class SourceBuffer {
+public:
+    // Map 'path' read-only.  Check isOpen() afterwards.
+    explicit SourceBuffer(const std::string& path);
+    // Wrap text produced in memory (e.g. auto-corrected source).
+    SourceBuffer(std::string displayPath, std::string text);
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&)            = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    bool               isOpen() const { return open; }
+    const std::string& path()   const { return filePath; }
+    std::string_view   view()   const { return {data, size}; }
+
+    // ── Line access for diagnostics (1-based, without '\n') ───
+    int              lineCount() const;
+    std::string_view lineText(int line) const;
+
+private:
+    std::string filePath;
+    std::string owned;            // backing store when not mmap'ed
+    const char* data   = nullptr;
+    size_t      size   = 0;
+    bool        mapped = false;
+    bool        open   = false;
+
+    mutable std::vector<size_t> lineStarts;   // built on first line query
+    void indexLines() const;
+};
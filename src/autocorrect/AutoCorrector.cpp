@@ -3,15 +3,17 @@
 #include <algorithm>
 #include <iostream>
 
-AutoCorrector::AutoCorrector(const std::string&               source,
+AutoCorrector::AutoCorrector(const SourceBuffer&              source,
                              const std::vector<LexError>&     le,
                              const std::vector<ParseError>&   pe,
                              const std::vector<CodeGenError>& ce)
     : lexErrs(le), parseErrs(pe), cgErrs(ce)
 {
-    std::istringstream ss(source);
-    std::string line;
-    while (std::getline(ss, line)) lines.push_back(line);
+    // Only lines are copied (they get edited); the split itself reuses the
+    // buffer's line index.
+    int n = source.lineCount();
+    lines.reserve(n);
+    for (int i = 1; i <= n; ++i) lines.emplace_back(source.lineText(i));
 }
 
 std::string AutoCorrector::correct() {
@@ -3,7 +3,12 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/IR/PassManager.h"
@@ -14,14 +19,86 @@
 #include "llvm/Transforms/Scalar/Reassociate.h"
 #include "llvm/Transforms/Scalar/SimplifyCFG.h"
 #include "llvm/Transforms/Utils/Mem2Reg.h"
+#include "llvm/MC/MCSubtargetInfo.h"
+#include "llvm/MC/SubtargetFeature.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 #include <iostream>
 
 // ── Constructor ────────────────────────────────────────────────
-CodeGen::CodeGen()
-    : builder(context),
+CodeGen::CodeGen(const CodeGenOptions& opts)
+    : ownedContext(std::make_unique<llvm::LLVMContext>()),
+      context(*ownedContext),
+      builder(context),
       module(std::make_unique<llvm::Module>("quail", context)),
-      currentThisAlloca(nullptr) {}
+      opts(opts),
+      currentThisAlloca(nullptr)
+{
+    if (opts.lean) context.setDiscardValueNames(true);
+    targetMachine = opts.target;
+    if (!targetMachine) {
+        std::string error;
+        targetMachine = createTargetMachine(opts, error);
+        if (!targetMachine) { addError(error); return; }
+    }
+    module->setTargetTriple(targetMachine->getTargetTriple().str());
+    module->setDataLayout(targetMachine->createDataLayout());
+}
+
+// ── Target machine ────────────────────────────────────────────
+std::unique_ptr<llvm::TargetMachine> CodeGen::createTargetMachine(const CodeGenOptions& opts,
+                                                                  std::string& error) {
+    static const bool initialized = [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        return true;
+    }();
+    (void)initialized;
+
+    std::string triple = llvm::sys::getDefaultTargetTriple();
+    const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+    if (!target) return nullptr;
+
+    std::string cpu = opts.targetCPU;
+    llvm::SubtargetFeatures features;
+    if (cpu == "native") {
+        cpu = llvm::sys::getHostCPUName().str();
+        llvm::StringMap<bool> host;
+        if (llvm::sys::getHostCPUFeatures(host))
+            for (auto& f : host) features.AddFeature(f.getKey(), f.getValue());
+    }
+    const std::vector<std::string> requested =
+        llvm::SubtargetFeatures(opts.targetFeatures).getFeatures();
+    for (const std::string& f : requested) features.AddFeature(f);
+
+    // LLVM only warns about unknown names and carries on with generic
+    // code, so they are checked first.  A known feature is one whose '+'
+    // or '-' form changes the CPU's feature bits.
+    auto subtarget = [&](const std::string& c, const std::string& fs) {
+        return std::unique_ptr<const llvm::MCSubtargetInfo>(
+            target->createMCSubtargetInfo(triple, c, fs));
+    };
+    if (!cpu.empty() && !subtarget("", "")->isCPUStringValid(cpu)) {
+        error = "Unknown target CPU '" + cpu + "' for " + triple;
+        return nullptr;
+    }
+    auto base = subtarget(cpu, "");
+    for (const std::string& f : requested) {
+        std::string name = llvm::SubtargetFeatures::StripFlag(f).str();
+        if (subtarget(cpu, "+" + name)->getFeatureBits() == base->getFeatureBits() &&
+            subtarget(cpu, "-" + name)->getFeatureBits() == base->getFeatureBits()) {
+            error = "Unknown target feature '" + f + "' for " + triple;
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<llvm::TargetMachine> tm(target->createTargetMachine(
+        triple, cpu, features.getString(), llvm::TargetOptions(), llvm::Reloc::PIC_));
+    if (!tm) error = "Cannot create a target machine for " + triple;
+    return tm;
+}
 
 // ── Error helper ──────────────────────────────────────────────
 void CodeGen::addError(const std::string& msg) {
@@ -29,6 +106,161 @@ void CodeGen::addError(const std::string& msg) {
     errors.push_back({msg});
 }
 
+std::nullptr_t CodeGen::internalError(const char* what) {
+    addError(std::string("[CodeGen] Internal: ") + what);
+    return nullptr;
+}
+
+// ══════════════════════════════════════════════════════════════
+//  Stack slots
+// ══════════════════════════════════════════════════════════════
+
+// Kept in creation order at the top of the entry block.
+llvm::AllocaInst* CodeGen::entryAlloca(llvm::Type* ty, const llvm::Twine& name) {
+    llvm::BasicBlock& entry = builder.GetInsertBlock()->getParent()->getEntryBlock();
+    llvm::IRBuilder<> at(&entry, lastAlloca ? std::next(lastAlloca->getIterator()) : entry.begin());
+    lastAlloca = at.CreateAlloca(ty, nullptr, name);
+    return lastAlloca;
+}
+
+// A block-scoped local: its lifetime starts at the declaration.
+llvm::AllocaInst* CodeGen::scopedAlloca(llvm::Type* ty, const llvm::Twine& name) {
+    auto* alloc = entryAlloca(ty, name);
+    if (scopeAllocas.empty()) return alloc;
+    builder.CreateLifetimeStart(alloc, builder.getInt64(module->getDataLayout().getTypeAllocSize(ty)));
+    scopeAllocas.back().push_back(alloc);
+    return alloc;
+}
+
+void CodeGen::endLifetimes(size_t fromScope) {
+    for (size_t s = scopeAllocas.size(); s-- > fromScope;)
+        for (auto it = scopeAllocas[s].rbegin(); it != scopeAllocas[s].rend(); ++it) {
+            llvm::Type* ty = (*it)->getAllocatedType();
+            builder.CreateLifetimeEnd(*it, builder.getInt64(module->getDataLayout().getTypeAllocSize(ty)));
+        }
+}
+
+// ══════════════════════════════════════════════════════════════
+//  Integer arithmetic  (--int-semantics, --div)
+// ══════════════════════════════════════════════════════════════
+
+// Branches to the function's shared trap block when 'cond' holds and
+// continues in a fresh block otherwise.
+void CodeGen::trapIf(llvm::Value* cond, const llvm::Twine& contName) {
+    auto* fn = builder.GetInsertBlock()->getParent();
+    if (!trapBlock) {
+        trapBlock = llvm::BasicBlock::Create(context, "trap", fn);
+        llvm::IRBuilder<> tb(trapBlock);
+        tb.CreateCall(llvm::Intrinsic::getDeclaration(module.get(), llvm::Intrinsic::trap));
+        tb.CreateUnreachable();
+    }
+    auto* cont = llvm::BasicBlock::Create(context, contName, fn);
+    builder.CreateCondBr(cond, trapBlock, cont,
+                         llvm::MDBuilder(context).createBranchWeights(1, (1U << 20) - 1));
+    builder.SetInsertPoint(cont);
+}
+
+// int + - * under opts.intSemantics.
+llvm::Value* CodeGen::intArith(llvm::Instruction::BinaryOps op, llvm::Value* l, llvm::Value* r,
+                               const llvm::Twine& name) {
+    switch (opts.intSemantics) {
+    case IntSemantics::Wrap:
+        return builder.CreateBinOp(op, l, r, name);
+    case IntSemantics::NSW:
+        return op == llvm::Instruction::Add ? builder.CreateNSWAdd(l, r, name)
+             : op == llvm::Instruction::Sub ? builder.CreateNSWSub(l, r, name)
+             :                                builder.CreateNSWMul(l, r, name);
+    case IntSemantics::Trap:
+        break;
+    }
+    llvm::Intrinsic::ID id = op == llvm::Instruction::Add ? llvm::Intrinsic::sadd_with_overflow
+                           : op == llvm::Instruction::Sub ? llvm::Intrinsic::ssub_with_overflow
+                           :                                llvm::Intrinsic::smul_with_overflow;
+    auto* res = builder.CreateBinaryIntrinsic(id, l, r);
+    trapIf(builder.CreateExtractValue(res, 1), name + ".ok");
+    return builder.CreateExtractValue(res, 0, name);
+}
+
+// int / under opts.div; under --int-semantics=trap INT_MIN / -1 traps too.
+llvm::Value* CodeGen::intDiv(llvm::Value* l, llvm::Value* r) {
+    auto* ty = l->getType();
+    auto* c  = llvm::dyn_cast<llvm::ConstantInt>(r);
+    if (!c || c->isZero()) {
+        switch (opts.div) {
+        case DivSemantics::Safe: {
+            auto* isZero = builder.CreateICmpEQ(r, llvm::ConstantInt::get(ty, 0), "divzero");
+            r = builder.CreateSelect(isZero, llvm::ConstantInt::get(ty, 1), r, "safe_div");
+            break;
+        }
+        case DivSemantics::Trap:
+            trapIf(builder.CreateICmpEQ(r, llvm::ConstantInt::get(ty, 0), "divzero"), "div.ok");
+            break;
+        case DivSemantics::Unchecked:
+            break;
+        }
+    }
+    if (opts.intSemantics == IntSemantics::Trap && (!c || c->isMinusOne())) {
+        auto* minL = builder.CreateICmpEQ(l, llvm::ConstantInt::get(ty, llvm::APInt::getSignedMinValue(32)));
+        auto* negR = builder.CreateICmpEQ(r, llvm::ConstantInt::getSigned(ty, -1));
+        trapIf(builder.CreateAnd(minL, negR, "divovf"), "div.ok");
+    }
+    return builder.CreateSDiv(l, r, "div");
+}
+
+// ══════════════════════════════════════════════════════════════
+//  Float arithmetic  (--fast-math, --fp-contract, 'fast')
+// ══════════════════════════════════════════════════════════════
+
+// Sets the builder's fast-math flags for the function about to be
+// generated and marks it with the matching FP and target attributes (the
+// latter so llc, reading the .ll back, picks the same CPU).
+void CodeGen::setFunctionAttrs(llvm::Function* fn, const PrototypeAST* proto) {
+    if (targetMachine) {
+        if (!targetMachine->getTargetCPU().empty())
+            fn->addFnAttr("target-cpu", targetMachine->getTargetCPU());
+        if (!targetMachine->getTargetFeatureString().empty())
+            fn->addFnAttr("target-features", targetMachine->getTargetFeatureString());
+    }
+    llvm::FastMathFlags fmf;
+    if (opts.fastMath || proto->fast) {
+        fmf.setFast();
+        for (const char* attr : {"unsafe-fp-math", "no-infs-fp-math", "no-nans-fp-math",
+                                 "no-signed-zeros-fp-math", "approx-func-fp-math"})
+            fn->addFnAttr(attr, "true");
+    } else if (opts.fpContract == FPContract::Fast) {
+        fmf.setAllowContract();
+    }
+    builder.setFastMathFlags(fmf);
+}
+
+// --fp-contract=on: a * b + c (or -) written as one expression becomes
+// llvm.fmuladd.  'l' and 'r' are the operands just generated, so an fmul
+// among them with no uses is that expression's own product.  Returns
+// null when neither operand is one.
+llvm::Value* CodeGen::fusedMulAdd(llvm::Value* l, llvm::Value* r, bool sub) {
+    if (opts.fpContract != FPContract::On || builder.getFastMathFlags().allowContract())
+        return nullptr;
+    auto product = [](llvm::Value* v) {
+        auto* i = llvm::dyn_cast<llvm::Instruction>(v);
+        return i && i->getOpcode() == llvm::Instruction::FMul && i->use_empty() ? i : nullptr;
+    };
+    llvm::Instruction* mul = product(l);
+    llvm::Value*       addend = r;
+    if (!mul) {
+        if (!(mul = product(r))) return nullptr;
+        addend = l;
+    }
+    llvm::Value* a = mul->getOperand(0);
+    llvm::Value* b = mul->getOperand(1);
+    mul->eraseFromParent();
+    if (sub) {
+        if (addend == r) addend = builder.CreateFNeg(addend, "fneg");   // a*b - c
+        else             a      = builder.CreateFNeg(a, "fneg");        // c - a*b
+    }
+    return builder.CreateIntrinsic(llvm::Intrinsic::fmuladd, {a->getType()}, {a, b, addend},
+                                   nullptr, "fmuladd");
+}
+
 // ══════════════════════════════════════════════════════════════
 //  Type helpers
 // ══════════════════════════════════════════════════════════════
@@ -76,7 +308,7 @@ llvm::Value* CodeGen::coerce(llvm::Value* val, llvm::Type* targetTy) {
     if (srcTy->isIntegerTy(32) && targetTy->isIntegerTy(1))
         return builder.CreateICmpNE(val,
             llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0), "int_to_bool");
-    addError("Type mismatch: cannot coerce types");
+    internalError("cannot coerce types");
     return val;
 }
 
@@ -121,7 +353,22 @@ void CodeGen::optimize(OptLevel level) {
         optStats.totalBlocksBefore += fs.blocksBefore;
         optStats.functions.push_back(fs);
     }
-    llvm::PassBuilder            PB;
+    runPipeline(*module, level, targetMachine.get());
+    size_t fi = 0;
+    for (auto& fn : *module) {
+        if (fn.isDeclaration()) continue;
+        if (fi < optStats.functions.size()) {
+            auto& fs = optStats.functions[fi++];
+            collectStats(fs, fn, false);
+            optStats.totalInstrAfter  += fs.instrAfter;
+            optStats.totalBlocksAfter += fs.blocksAfter;
+        }
+    }
+}
+
+void CodeGen::runPipeline(llvm::Module& m, OptLevel level, llvm::TargetMachine* target) {
+    if (level == OptLevel::O0) return;
+    llvm::PassBuilder            PB(target);
     llvm::LoopAnalysisManager    LAM;
     llvm::FunctionAnalysisManager FAM;
     llvm::CGSCCAnalysisManager   CGAM;
@@ -140,23 +387,13 @@ void CodeGen::optimize(OptLevel level) {
         FPM.addPass(llvm::GVNPass());
         FPM.addPass(llvm::SimplifyCFGPass());
         MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
-        MPM.run(*module, MAM);
+        MPM.run(m, MAM);
     } else if (level == OptLevel::O2) {
         auto MPM = PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
-        MPM.run(*module, MAM);
+        MPM.run(m, MAM);
     } else if (level == OptLevel::O3) {
         auto MPM = PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
-        MPM.run(*module, MAM);
-    }
-    size_t fi = 0;
-    for (auto& fn : *module) {
-        if (fn.isDeclaration()) continue;
-        if (fi < optStats.functions.size()) {
-            auto& fs = optStats.functions[fi++];
-            collectStats(fs, fn, false);
-            optStats.totalInstrAfter  += fs.instrAfter;
-            optStats.totalBlocksAfter += fs.blocksAfter;
-        }
+        MPM.run(m, MAM);
     }
 }
 
@@ -167,31 +404,13 @@ void CodeGen::optimize(OptLevel level) {
 llvm::Value* CodeGen::fieldGEPFromPtr(llvm::StructType* structTy,
                                        llvm::Value*      objPtr,
                                        int               fieldIdx,
-                                       const std::string& tag)
+                                       const llvm::Twine& tag)
 {
     auto* zero = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
     auto* fidx = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), fieldIdx);
     return builder.CreateGEP(structTy, objPtr, {zero, fidx}, tag);
 }
 
-llvm::Value* CodeGen::fieldGEP(const Symbol* sym,
-                                const std::string& fieldName,
-                                const std::string& tag)
-{
-    auto it = classInfos.find(sym->objectClass);
-    if (it == classInfos.end()) {
-        addError("Unknown class '" + sym->objectClass + "'");
-        return nullptr;
-    }
-    int idx = it->second.fieldIndex(fieldName);
-    if (idx < 0) {
-        addError("Class '" + sym->objectClass + "' has no field '" + fieldName + "'");
-        return nullptr;
-    }
-    return fieldGEPFromPtr(it->second.llvmType, sym->value, idx,
-                           tag.empty() ? sym->name + "." + fieldName : tag);
-}
-
 // ══════════════════════════════════════════════════════════════
 //  OOP — method generation
 //
@@ -204,50 +423,43 @@ llvm::Value* CodeGen::fieldGEP(const Symbol* sym,
 // ══════════════════════════════════════════════════════════════
 
 void CodeGen::generateMethod(FunctionAST* f,
-                              const std::string& className,
+                              Atom               className,
                               llvm::StructType*  structTy)
 {
     // Build LLVM parameter list: (ClassName* this_arg, param0, param1, ...)
     auto* structPtrTy = llvm::PointerType::get(structTy, 0);
 
     std::vector<llvm::Type*> paramTypes;
-    std::vector<ValueType>   paramVT;
     paramTypes.push_back(structPtrTy);          // implicit this*
-    paramVT.push_back(ValueType::Unknown);      // placeholder
 
     for (size_t i = 0; i < f->proto->args.size(); ++i) {
         ASTType at = (i < f->proto->argTypes.size())
                      ? f->proto->argTypes[i]
                      : ASTType::Int;
         paramTypes.push_back(llvmType(at));
-        paramVT.push_back(astToValueType(at));
     }
 
     llvm::Type* retTy      = llvmType(f->proto->returnType);
     auto*       ft         = llvm::FunctionType::get(retTy, paramTypes, false);
-    std::string mangledName = className + "_" + f->proto->name;
+    Atom        mangledName = Atom::intern(className + "_" + f->proto->name);
 
     auto* fn = llvm::Function::Create(ft,
-                   llvm::Function::ExternalLinkage, mangledName, *module);
-
-    // Register method as a function symbol at global scope
-    std::vector<ValueType> regParams(paramVT.begin() + 1, paramVT.end());
-    try {
-        symbols.insertFunction(mangledName,
-                               astToValueType(f->proto->returnType),
-                               regParams, fn);
-    } catch (...) { /* redefinition guard — ignore duplicate */ }
+                   llvm::Function::ExternalLinkage, mangledName.str(), *module);
+    classInfos[className].methods.emplace(f->proto->name, fn);
+    functions.emplace(mangledName, fn);
 
     auto* entry = llvm::BasicBlock::Create(context, "entry", fn);
     builder.SetInsertPoint(entry);
-    symbols.enterScope();
-    symbols.setCurrentFunction(mangledName);
+    setFunctionAttrs(fn, f->proto);
+    lastAlloca = nullptr;
+    trapBlock  = nullptr;
+    locals.assign(f->slotCount, Local{});
 
     // ── Alloca for 'this' pointer ──────────────────────────────
     auto argIt = fn->args().begin();
     argIt->setName("this_arg");
 
-    auto* thisPtrAlloca = builder.CreateAlloca(structPtrTy, nullptr, "this.addr");
+    auto* thisPtrAlloca = entryAlloca(structPtrTy, "this.addr");
     builder.CreateStore(&*argIt, thisPtrAlloca);
     currentThisAlloca = thisPtrAlloca;
     ++argIt;
@@ -262,20 +474,18 @@ void CodeGen::generateMethod(FunctionAST* f,
                      "': LLVM arg count exceeds prototype arg count");
             break;
         }
-        const std::string& pname = f->proto->args[idx];
+        Atom pname = f->proto->args[idx];
         ASTType at = (idx < f->proto->argTypes.size())
                      ? f->proto->argTypes[idx]
                      : ASTType::Int;
-        auto* alloc = builder.CreateAlloca(llvmType(at), nullptr, pname);
+        auto* alloc = entryAlloca(llvmType(at), pname.str());
         builder.CreateStore(&*it, alloc);
-        try {
-            symbols.insert(pname, astToValueType(at), SymbolKind::Parameter, alloc);
-        } catch (const std::runtime_error& e) { addError(e.what()); }
+        setLocal((int)idx, alloc, astToValueType(at));
         (void)idx; // idx is incremented by the for-header; suppress unused-value warning
     }
 
     // ── Generate body ──────────────────────────────────────────
-    generate(f->body.get());
+    generate(f->body);
 
     // ── Auto return if missing ─────────────────────────────────
     if (!builder.GetInsertBlock()->getTerminator()) {
@@ -285,9 +495,8 @@ void CodeGen::generateMethod(FunctionAST* f,
     }
 
     currentThisAlloca = nullptr;
-    symbols.clearCurrentFunction();
-    symbols.exitScope();
 
+    if (opts.lean) return;
     std::string errStr;
     llvm::raw_string_ostream errStream(errStr);
     if (llvm::verifyFunction(*fn, &errStream))
@@ -299,20 +508,21 @@ void CodeGen::generateMethod(FunctionAST* f,
 // ══════════════════════════════════════════════════════════════
 
 llvm::Value* CodeGen::generate(AST* node) {
-    if (!node) {
-        addError("[CodeGen] Internal: null AST node");
-        return nullptr;
-    }
+    if (!node) return internalError("null AST node");
+
+    switch (node->kind) {
 
     // ── Comments ───────────────────────────────────────────────
-    if (dynamic_cast<LineCommentAST*>(node))  return nullptr;
-    if (dynamic_cast<BlockCommentAST*>(node)) return nullptr;
+    case ASTKind::LineComment:
+    case ASTKind::BlockComment:
+        return nullptr;
 
     // ════════════════════════════════════════════════════════════
     //  OOP — Class declaration
     //  Registers the struct type and generates all methods.
     // ════════════════════════════════════════════════════════════
-    if (auto* cls = dynamic_cast<ClassDeclAST*>(node)) {
+    case ASTKind::ClassDecl: {
+        auto* cls = static_cast<ClassDeclAST*>(node);
         // Build LLVM struct field types
         std::vector<llvm::Type*> fieldLLVMTypes;
         ClassInfo info;
@@ -323,7 +533,7 @@ llvm::Value* CodeGen::generate(AST* node) {
             info.fields.push_back({f.name, astToValueType(f.type)});
         }
 
-        auto* structTy = llvm::StructType::create(context, fieldLLVMTypes, cls->name);
+        auto* structTy = llvm::StructType::create(context, fieldLLVMTypes, cls->name.str());
         info.llvmType  = structTy;
         classTypes[cls->name]  = structTy;
         classInfos[cls->name]  = info;
@@ -331,8 +541,8 @@ llvm::Value* CodeGen::generate(AST* node) {
         // Generate each method
         currentClassName = cls->name;
         for (auto& method : cls->methods)
-            generateMethod(method.get(), cls->name, structTy);
-        currentClassName.clear();
+            generateMethod(method, cls->name, structTy);
+        currentClassName = Atom();
 
         return nullptr;
     }
@@ -340,73 +550,50 @@ llvm::Value* CodeGen::generate(AST* node) {
     // ════════════════════════════════════════════════════════════
     //  OOP — Object declaration  (ClassName varName;)
     // ════════════════════════════════════════════════════════════
-    if (auto* od = dynamic_cast<ObjectDeclAST*>(node)) {
+    case ASTKind::ObjectDecl: {
+        auto* od = static_cast<ObjectDeclAST*>(node);
         auto it = classTypes.find(od->className);
-        if (it == classTypes.end()) {
-            addError("Unknown class '" + od->className + "'");
-            return nullptr;
-        }
-        if (symbols.isDeclaredInCurrentScope(od->varName)) {
-            addError("Redeclaration of '" + od->varName + "' in same scope");
-            return nullptr;
-        }
-        auto* alloc = builder.CreateAlloca(it->second, nullptr, od->varName);
+        if (it == classTypes.end()) return internalError("unknown class");
+        auto* alloc = scopedAlloca(it->second, od->varName.str());
         // Zero-initialize all fields (mirrors Java/C# default field values).
         // Without this, any field read before an explicit setter call yields UB.
         builder.CreateStore(llvm::Constant::getNullValue(it->second), alloc);
-        try {
-            symbols.insert(od->varName, ValueType::Unknown, SymbolKind::Object,
-                           alloc, 0, od->className);
-        } catch (const std::runtime_error& e) { addError(e.what()); }
+        setLocal(od->slot, alloc, ValueType::Unknown, od->className);
         return alloc;
     }
 
     // ════════════════════════════════════════════════════════════
     //  OOP — Member access  (obj.field  in expression)
     // ════════════════════════════════════════════════════════════
-    if (auto* ma = dynamic_cast<MemberAccessAST*>(node)) {
-        const Symbol* sym = symbols.lookup(ma->objName);
-        if (!sym) { addError("Use of undeclared object '" + ma->objName + "'"); return nullptr; }
-        if (sym->kind != SymbolKind::Object) {
-            addError("'" + ma->objName + "' is not an object"); return nullptr;
-        }
-        auto it = classInfos.find(sym->objectClass);
-        if (it == classInfos.end()) { addError("Unknown class '" + sym->objectClass + "'"); return nullptr; }
-
-        int idx = it->second.fieldIndex(ma->memberName);
-        if (idx < 0) {
-            addError("'" + sym->objectClass + "' has no field '" + ma->memberName + "'");
-            return nullptr;
-        }
-        auto* gep = fieldGEPFromPtr(it->second.llvmType, sym->value, idx,
-                                    ma->objName + "." + ma->memberName + ".ptr");
+    case ASTKind::MemberAccess: {
+        auto* ma = static_cast<MemberAccessAST*>(node);
+        const Local* obj = local(ma->slot);
+        if (!obj) return internalError("unbound object");
+        auto it = classInfos.find(obj->objectClass);
+        int idx = it != classInfos.end() ? it->second.fieldIndex(ma->memberName) : -1;
+        if (idx < 0) return internalError("unknown field");
+        auto* gep = fieldGEPFromPtr(it->second.llvmType, obj->value, idx,
+                                    llvm::Twine(ma->objName.str()) + "." + ma->memberName.str() + ".ptr");
         ValueType ft = it->second.fieldType(ma->memberName);
-        return builder.CreateLoad(llvmType(ft), gep, ma->memberName);
+        return builder.CreateLoad(llvmType(ft), gep, ma->memberName.str());
     }
 
     // ════════════════════════════════════════════════════════════
     //  OOP — Member assign  (obj.field = expr;)
     // ════════════════════════════════════════════════════════════
-    if (auto* ma = dynamic_cast<MemberAssignAST*>(node)) {
-        const Symbol* sym = symbols.lookup(ma->objName);
-        if (!sym) { addError("Assignment to undeclared object '" + ma->objName + "'"); return nullptr; }
-        if (sym->kind != SymbolKind::Object) {
-            addError("'" + ma->objName + "' is not an object"); return nullptr;
-        }
-        auto it = classInfos.find(sym->objectClass);
-        if (it == classInfos.end()) { addError("Unknown class '" + sym->objectClass + "'"); return nullptr; }
-
-        int idx = it->second.fieldIndex(ma->memberName);
-        if (idx < 0) {
-            addError("'" + sym->objectClass + "' has no field '" + ma->memberName + "'");
-            return nullptr;
-        }
-        auto* val = generate(ma->expr.get());
+    case ASTKind::MemberAssign: {
+        auto* ma = static_cast<MemberAssignAST*>(node);
+        const Local* obj = local(ma->slot);
+        if (!obj) return internalError("unbound object");
+        auto it = classInfos.find(obj->objectClass);
+        int idx = it != classInfos.end() ? it->second.fieldIndex(ma->memberName) : -1;
+        if (idx < 0) return internalError("unknown field");
+        auto* val = generate(ma->expr);
         if (!val) return nullptr;
         ValueType ft  = it->second.fieldType(ma->memberName);
         val = coerce(val, llvmType(ft));
-        auto* gep = fieldGEPFromPtr(it->second.llvmType, sym->value, idx,
-                                    ma->objName + "." + ma->memberName + ".ptr");
+        auto* gep = fieldGEPFromPtr(it->second.llvmType, obj->value, idx,
+                                    llvm::Twine(ma->objName.str()) + "." + ma->memberName.str() + ".ptr");
         builder.CreateStore(val, gep);
         return val;
     }
@@ -414,49 +601,38 @@ llvm::Value* CodeGen::generate(AST* node) {
     // ════════════════════════════════════════════════════════════
     //  OOP — Method call  (obj.method(args)  or  this.method(args))
     // ════════════════════════════════════════════════════════════
-    if (auto* mc = dynamic_cast<MethodCallAST*>(node)) {
-        std::string className;
+    case ASTKind::MethodCall: {
+        auto* mc = static_cast<MethodCallAST*>(node);
+        Atom         className;
         llvm::Value* thisPtr = nullptr;
 
-        if (mc->objName == "this") {
+        if (mc->objName == thisAtom()) {
             // Self-call inside a method
-            if (currentClassName.empty() || !currentThisAlloca) {
-                addError("'this' method call outside of a method");
-                return nullptr;
-            }
+            if (currentClassName.empty() || !currentThisAlloca)
+                return internalError("'this' outside a method");
             className = currentClassName;
             auto* structPtrTy = llvm::PointerType::get(classTypes[className], 0);
             thisPtr = builder.CreateLoad(structPtrTy, currentThisAlloca, "this");
+        } else if (const Local* obj = local(mc->slot)) {
+            className = obj->objectClass;
+            thisPtr   = obj->value;   // already a %ClassName*
         } else {
-            const Symbol* sym = symbols.lookup(mc->objName);
-            if (!sym) { addError("Use of undeclared object '" + mc->objName + "'"); return nullptr; }
-            if (sym->kind != SymbolKind::Object) {
-                addError("'" + mc->objName + "' is not an object"); return nullptr;
-            }
-            className = sym->objectClass;
-            thisPtr   = sym->value;   // already a %ClassName*
+            return internalError("unbound object");
         }
 
-        std::string mangledName = className + "_" + mc->methodName;
-        auto* fn = module->getFunction(mangledName);
-        if (!fn) {
-            addError("Method '" + mc->methodName + "' not found in class '" + className + "'");
-            return nullptr;
-        }
-
-        // Build argument list: (this, arg0, arg1, ...)
-        size_t expectedArgs = fn->arg_size() - 1; // exclude implicit this
-        if (expectedArgs != mc->args.size()) {
-            addError("Wrong argument count to '" + className + "::" + mc->methodName +
-                     "': expected " + std::to_string(expectedArgs) +
-                     ", got " + std::to_string(mc->args.size()));
-            return nullptr;
+        llvm::Function* fn = nullptr;
+        auto cls = classInfos.find(className);
+        if (cls != classInfos.end()) {
+            auto m = cls->second.methods.find(mc->methodName);
+            if (m != cls->second.methods.end()) fn = m->second;
         }
+        // Argument list: (this, arg0, arg1, ...)
+        if (!fn || fn->arg_size() - 1 != mc->args.size()) return internalError("unresolved method call");
 
         std::vector<llvm::Value*> args;
         args.push_back(thisPtr);
         for (size_t pi = 0; pi < mc->args.size(); ++pi) {
-            auto* v = generate(mc->args[pi].get());
+            auto* v = generate(mc->args[pi]);
             if (!v) return nullptr;
             llvm::Type* expectedTy = fn->getFunctionType()->getParamType(pi + 1);
             v = coerce(v, expectedTy);
@@ -464,57 +640,43 @@ llvm::Value* CodeGen::generate(AST* node) {
         }
 
         return builder.CreateCall(fn, args,
-               fn->getReturnType()->isVoidTy() ? "" : "call_" + mc->methodName);
+               fn->getReturnType()->isVoidTy() ? llvm::Twine() : "call_" + llvm::Twine(mc->methodName.str()));
     }
 
     // ════════════════════════════════════════════════════════════
     //  OOP — this.field access  (inside a method)
     // ════════════════════════════════════════════════════════════
-    if (auto* ta = dynamic_cast<ThisAccessAST*>(node)) {
-        if (!currentThisAlloca || currentClassName.empty()) {
-            addError("'this' used outside of a method");
-            return nullptr;
-        }
+    case ASTKind::ThisAccess: {
+        auto* ta = static_cast<ThisAccessAST*>(node);
+        if (!currentThisAlloca || currentClassName.empty()) return internalError("'this' outside a method");
         auto it = classInfos.find(currentClassName);
-        if (it == classInfos.end()) { addError("Unknown class '" + currentClassName + "'"); return nullptr; }
-
-        int idx = it->second.fieldIndex(ta->memberName);
-        if (idx < 0) {
-            addError("'" + currentClassName + "' has no field '" + ta->memberName + "'");
-            return nullptr;
-        }
+        int idx = it != classInfos.end() ? it->second.fieldIndex(ta->memberName) : -1;
+        if (idx < 0) return internalError("unknown field");
         auto* structPtrTy = llvm::PointerType::get(it->second.llvmType, 0);
         auto* thisPtr     = builder.CreateLoad(structPtrTy, currentThisAlloca, "this");
         auto* gep         = fieldGEPFromPtr(it->second.llvmType, thisPtr, idx,
-                                            "this." + ta->memberName + ".ptr");
+                                            llvm::Twine("this.") + ta->memberName.str() + ".ptr");
         ValueType ft      = it->second.fieldType(ta->memberName);
-        return builder.CreateLoad(llvmType(ft), gep, ta->memberName);
+        return builder.CreateLoad(llvmType(ft), gep, ta->memberName.str());
     }
 
     // ════════════════════════════════════════════════════════════
     //  OOP — this.field = expr  (inside a method)
     // ════════════════════════════════════════════════════════════
-    if (auto* ta = dynamic_cast<ThisAssignAST*>(node)) {
-        if (!currentThisAlloca || currentClassName.empty()) {
-            addError("'this' assignment outside of a method");
-            return nullptr;
-        }
+    case ASTKind::ThisAssign: {
+        auto* ta = static_cast<ThisAssignAST*>(node);
+        if (!currentThisAlloca || currentClassName.empty()) return internalError("'this' outside a method");
         auto it = classInfos.find(currentClassName);
-        if (it == classInfos.end()) { addError("Unknown class '" + currentClassName + "'"); return nullptr; }
-
-        int idx = it->second.fieldIndex(ta->memberName);
-        if (idx < 0) {
-            addError("'" + currentClassName + "' has no field '" + ta->memberName + "'");
-            return nullptr;
-        }
-        auto* val         = generate(ta->expr.get());
+        int idx = it != classInfos.end() ? it->second.fieldIndex(ta->memberName) : -1;
+        if (idx < 0) return internalError("unknown field");
+        auto* val         = generate(ta->expr);
         if (!val) return nullptr;
         ValueType ft      = it->second.fieldType(ta->memberName);
         val               = coerce(val, llvmType(ft));
         auto* structPtrTy = llvm::PointerType::get(it->second.llvmType, 0);
         auto* thisPtr     = builder.CreateLoad(structPtrTy, currentThisAlloca, "this");
         auto* gep         = fieldGEPFromPtr(it->second.llvmType, thisPtr, idx,
-                                            "this." + ta->memberName + ".ptr");
+                                            llvm::Twine("this.") + ta->memberName.str() + ".ptr");
         builder.CreateStore(val, gep);
         return val;
     }
@@ -524,40 +686,33 @@ llvm::Value* CodeGen::generate(AST* node) {
     // ════════════════════════════════════════════════════════════
 
     // ── Integer literal ────────────────────────────────────────
-    if (auto* n = dynamic_cast<NumberAST*>(node))
-        return llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), n->val);
+    case ASTKind::Number:
+        return llvm::ConstantInt::get(llvm::Type::getInt32Ty(context),
+                                      static_cast<NumberAST*>(node)->val);
 
     // ── Float literal ──────────────────────────────────────────
-    if (auto* f = dynamic_cast<FloatAST*>(node))
-        return llvm::ConstantFP::get(llvm::Type::getDoubleTy(context), f->val);
+    case ASTKind::Float:
+        return llvm::ConstantFP::get(llvm::Type::getDoubleTy(context),
+                                     static_cast<FloatAST*>(node)->val);
 
     // ── Variable reference ─────────────────────────────────────
-    if (auto* v = dynamic_cast<VariableAST*>(node)) {
-        const Symbol* sym = symbols.lookup(v->name);
-        if (!sym) { addError("Use of undeclared variable '" + v->name + "'"); return nullptr; }
-        if (sym->kind == SymbolKind::Function) {
-            addError("'" + v->name + "' is a function, not a variable"); return nullptr;
-        }
-        if (sym->kind == SymbolKind::Object) {
-            // Using an object as a value is not directly supported yet
-            addError("Cannot use object '" + v->name + "' as a scalar value"); return nullptr;
-        }
-        return builder.CreateLoad(llvmType(sym->type), sym->value, v->name);
+    case ASTKind::Variable: {
+        auto* v = static_cast<VariableAST*>(node);
+        const Local* l = local(v->slot);
+        if (!l) return internalError("unbound variable");
+        return builder.CreateLoad(llvmType(l->type), l->value, v->name.str());
     }
 
     // ── Variable declaration with initializer (in-place, no child scope) ─────
     // Handles:  int name = expr;
     // This keeps 'name' alive in the current scope so subsequent statements
     // (e.g. return name;) can see it — unlike the old BlockAST wrapper.
-    if (auto* vi = dynamic_cast<VarDeclInitAST*>(node)) {
-        if (symbols.isDeclaredInCurrentScope(vi->name)) {
-            addError("Redeclaration of '" + vi->name + "' in same scope"); return nullptr;
-        }
+    case ASTKind::VarDeclInit: {
+        auto* vi = static_cast<VarDeclInitAST*>(node);
         llvm::Type* ty    = llvmType(vi->type);
-        auto*       alloc = builder.CreateAlloca(ty, nullptr, vi->name);
-        try { symbols.insert(vi->name, astToValueType(vi->type), SymbolKind::Variable, alloc); }
-        catch (const std::runtime_error& e) { addError(e.what()); return nullptr; }
-        auto* initVal = generate(vi->init.get());
+        auto*       alloc = scopedAlloca(ty, vi->name.str());
+        setLocal(vi->slot, alloc, astToValueType(vi->type));
+        auto* initVal = generate(vi->init);
         if (!initVal) return nullptr;
         initVal = coerce(initVal, ty);
         builder.CreateStore(initVal, alloc);
@@ -565,32 +720,30 @@ llvm::Value* CodeGen::generate(AST* node) {
     }
 
     // ── Variable declaration ───────────────────────────────────
-    if (auto* vd = dynamic_cast<VarDeclAST*>(node)) {
-        if (symbols.isDeclaredInCurrentScope(vd->name)) {
-            addError("Redeclaration of '" + vd->name + "' in same scope"); return nullptr;
-        }
+    case ASTKind::VarDecl: {
+        auto* vd = static_cast<VarDeclAST*>(node);
         llvm::Type* ty    = llvmType(vd->type);
-        auto*       alloc = builder.CreateAlloca(ty, nullptr, vd->name);
-        try { symbols.insert(vd->name, astToValueType(vd->type), SymbolKind::Variable, alloc); }
-        catch (const std::runtime_error& e) { addError(e.what()); }
+        auto*       alloc = scopedAlloca(ty, vd->name.str());
+        setLocal(vd->slot, alloc, astToValueType(vd->type));
         return alloc;
     }
 
     // ── Assignment ─────────────────────────────────────────────
-    if (auto* a = dynamic_cast<AssignAST*>(node)) {
-        Symbol* sym = symbols.lookup(a->name);
-        if (!sym) { addError("Assignment to undeclared variable '" + a->name + "'"); return nullptr; }
-        auto* val = generate(a->expr.get());
+    case ASTKind::Assign: {
+        auto* a = static_cast<AssignAST*>(node);
+        const Local* dst = local(a->slot);
+        if (!dst) return internalError("unbound variable");
+        auto* val = generate(a->expr);
         if (!val) return nullptr;
-        val = coerce(val, llvmType(sym->type));
-        if (!val) return nullptr;
-        builder.CreateStore(val, sym->value);
+        val = coerce(val, llvmType(dst->type));
+        builder.CreateStore(val, dst->value);
         return val;
     }
 
     // ── If / If-Else ───────────────────────────────────────────
-    if (auto* i = dynamic_cast<IfAST*>(node)) {
-        auto* condVal = generate(i->cond.get());
+    case ASTKind::If: {
+        auto* i = static_cast<IfAST*>(node);
+        auto* condVal = generate(i->cond);
         if (!condVal) return nullptr;
         auto* cond    = toBool(condVal);
         if (!cond) return nullptr;
@@ -600,38 +753,41 @@ llvm::Value* CodeGen::generate(AST* node) {
         auto* mergeBB = llvm::BasicBlock::Create(context, "ifcont", fn);
         builder.CreateCondBr(cond, thenBB, elseBB);
         builder.SetInsertPoint(thenBB);
-        generate(i->thenBlock.get());
+        generate(i->thenBlock);
         if (!builder.GetInsertBlock()->getTerminator()) builder.CreateBr(mergeBB);
         builder.SetInsertPoint(elseBB);
-        if (i->elseBlock) generate(i->elseBlock.get());
+        if (i->elseBlock) generate(i->elseBlock);
         if (!builder.GetInsertBlock()->getTerminator()) builder.CreateBr(mergeBB);
         builder.SetInsertPoint(mergeBB);
         return nullptr;
     }
 
     // ── While ──────────────────────────────────────────────────
-    if (auto* w = dynamic_cast<WhileAST*>(node)) {
+    case ASTKind::While: {
+        auto* w = static_cast<WhileAST*>(node);
         auto* fn      = builder.GetInsertBlock()->getParent();
         auto* condBB  = llvm::BasicBlock::Create(context, "while.cond", fn);
         auto* bodyBB  = llvm::BasicBlock::Create(context, "while.body", fn);
         auto* afterBB = llvm::BasicBlock::Create(context, "while.end",  fn);
         builder.CreateBr(condBB);
         builder.SetInsertPoint(condBB);
-        auto* cond = toBool(generate(w->cond.get()));
+        auto* cond = toBool(generate(w->cond));
         if (!cond) return nullptr;
         builder.CreateCondBr(cond, bodyBB, afterBB);
         builder.SetInsertPoint(bodyBB);
         breakStack.push_back(afterBB); continueStack.push_back(condBB);
-        generate(w->body.get());
-        breakStack.pop_back(); continueStack.pop_back();
+        loopScopes.push_back(scopeAllocas.size());
+        generate(w->body);
+        breakStack.pop_back(); continueStack.pop_back(); loopScopes.pop_back();
         if (!builder.GetInsertBlock()->getTerminator()) builder.CreateBr(condBB);
         builder.SetInsertPoint(afterBB);
         return nullptr;
     }
 
     // ── For loop ───────────────────────────────────────────────
-    if (auto* f = dynamic_cast<ForAST*>(node)) {
-        if (f->init) generate(f->init.get());
+    case ASTKind::For: {
+        auto* f = static_cast<ForAST*>(node);
+        if (f->init) generate(f->init);
         auto* fn      = builder.GetInsertBlock()->getParent();
         auto* condBB  = llvm::BasicBlock::Create(context, "for.cond", fn);
         auto* bodyBB  = llvm::BasicBlock::Create(context, "for.body", fn);
@@ -639,66 +795,67 @@ llvm::Value* CodeGen::generate(AST* node) {
         auto* endBB   = llvm::BasicBlock::Create(context, "for.end",  fn);
         builder.CreateBr(condBB);
         builder.SetInsertPoint(condBB);
-        llvm::Value* condVal = f->cond ? generate(f->cond.get()) : nullptr;
+        llvm::Value* condVal = f->cond ? generate(f->cond) : nullptr;
         auto* cond = condVal ? toBool(condVal) : llvm::ConstantInt::getTrue(context);
         builder.CreateCondBr(cond, bodyBB, endBB);
         builder.SetInsertPoint(bodyBB);
         breakStack.push_back(endBB); continueStack.push_back(incBB);
-        generate(f->body.get());
-        breakStack.pop_back(); continueStack.pop_back();
+        loopScopes.push_back(scopeAllocas.size());
+        generate(f->body);
+        breakStack.pop_back(); continueStack.pop_back(); loopScopes.pop_back();
         if (!builder.GetInsertBlock()->getTerminator()) builder.CreateBr(incBB);
         builder.SetInsertPoint(incBB);
-        if (f->inc) generate(f->inc.get());
+        if (f->inc) generate(f->inc);
         builder.CreateBr(condBB);
         builder.SetInsertPoint(endBB);
         return nullptr;
     }
 
     // ── Block ──────────────────────────────────────────────────
-    if (auto* b = dynamic_cast<BlockAST*>(node)) {
-        symbols.enterScope();
+    case ASTKind::Block: {
+        auto* b = static_cast<BlockAST*>(node);
+        scopeAllocas.emplace_back();
         for (auto& stmt : b->statements) {
-            generate(stmt.get());
+            generate(stmt);
             if (builder.GetInsertBlock()->getTerminator()) break;
         }
-        symbols.exitScope();
+        if (!builder.GetInsertBlock()->getTerminator()) endLifetimes(scopeAllocas.size() - 1);
+        scopeAllocas.pop_back();
         return nullptr;
     }
 
     // ── Function definition ────────────────────────────────────
-    if (auto* f = dynamic_cast<FunctionAST*>(node)) {
+    case ASTKind::Function: {
+        auto* f = static_cast<FunctionAST*>(node);
         std::vector<llvm::Type*> paramTypes;
-        std::vector<ValueType>   paramVT;
         for (size_t i = 0; i < f->proto->args.size(); ++i) {
             ASTType at = (i < f->proto->argTypes.size()) ? f->proto->argTypes[i] : ASTType::Int;
             paramTypes.push_back(llvmType(at));
-            paramVT.push_back(astToValueType(at));
         }
         llvm::Type* retTy = llvmType(f->proto->returnType);
         auto* ft  = llvm::FunctionType::get(retTy, paramTypes, false);
         auto* fn  = llvm::Function::Create(ft, llvm::Function::ExternalLinkage,
-                                           f->proto->name, *module);
-        try {
-            symbols.insertFunction(f->proto->name, astToValueType(f->proto->returnType), paramVT, fn);
-        } catch (const std::runtime_error& e) { addError(e.what()); fn->eraseFromParent(); return nullptr; }
+                                           f->proto->name.str(), *module);
+        functions.emplace(f->proto->name, fn);
 
         auto* entry = llvm::BasicBlock::Create(context, "entry", fn);
         builder.SetInsertPoint(entry);
-        symbols.enterScope();
-        symbols.setCurrentFunction(f->proto->name);
+        setFunctionAttrs(fn, f->proto);
+        lastAlloca = nullptr;
+        trapBlock  = nullptr;
+        locals.assign(f->slotCount, Local{});
 
         size_t idx = 0;
         for (auto& arg : fn->args()) {
-            const std::string& pname = f->proto->args[idx];
+            Atom pname = f->proto->args[idx];
             ASTType at = (idx < f->proto->argTypes.size()) ? f->proto->argTypes[idx] : ASTType::Int;
-            auto* alloc = builder.CreateAlloca(llvmType(at), nullptr, pname);
+            auto* alloc = entryAlloca(llvmType(at), pname.str());
             builder.CreateStore(&arg, alloc);
-            try { symbols.insert(pname, astToValueType(at), SymbolKind::Parameter, alloc); }
-            catch (const std::runtime_error& e) { addError(e.what()); }
+            setLocal((int)idx, alloc, astToValueType(at));
             idx++;
         }
 
-        generate(f->body.get());
+        generate(f->body);
 
         if (!builder.GetInsertBlock()->getTerminator()) {
             if (retTy->isVoidTy())        builder.CreateRetVoid();
@@ -706,30 +863,25 @@ llvm::Value* CodeGen::generate(AST* node) {
             else                          builder.CreateRet(llvm::ConstantInt::get(retTy, 0));
         }
 
-        symbols.clearCurrentFunction();
-        symbols.exitScope();
-
-        std::string errStr;
-        llvm::raw_string_ostream errStream(errStr);
-        if (llvm::verifyFunction(*fn, &errStream))
-            addError("LLVM IR verify failed for '" + f->proto->name + "': " + errStream.str());
+        if (!opts.lean) {
+            std::string errStr;
+            llvm::raw_string_ostream errStream(errStr);
+            if (llvm::verifyFunction(*fn, &errStream))
+                addError("LLVM IR verify failed for '" + f->proto->name + "': " + errStream.str());
+        }
         return fn;
     }
 
     // ── Function call ──────────────────────────────────────────
-    if (auto* c = dynamic_cast<CallAST*>(node)) {
-        auto* fn = module->getFunction(c->callee);
-        if (!fn) { addError("Call to undefined function '" + c->callee + "'"); return nullptr; }
-        if (fn->arg_size() != c->args.size()) {
-            addError("Wrong argument count to '" + c->callee + "': expected "
-                     + std::to_string(fn->arg_size())
-                     + ", got " + std::to_string(c->args.size()));
-            return nullptr;
-        }
+    case ASTKind::Call: {
+        auto* c = static_cast<CallAST*>(node);
+        auto found = functions.find(c->callee);
+        llvm::Function* fn = found != functions.end() ? found->second : nullptr;
+        if (!fn || fn->arg_size() != c->args.size()) return internalError("unresolved call");
         std::vector<llvm::Value*> args;
         size_t pi = 0;
         for (auto& a : c->args) {
-            auto* v = generate(a.get()); if (!v) return nullptr;
+            auto* v = generate(a); if (!v) return nullptr;
             v = coerce(v, fn->getFunctionType()->getParamType(pi++));
             args.push_back(v);
         }
@@ -737,200 +889,268 @@ llvm::Value* CodeGen::generate(AST* node) {
     }
 
     // ── Array declaration ──────────────────────────────────────
-    if (auto* a = dynamic_cast<ArrayDeclAST*>(node)) {
-        if (a->size <= 0) { addError("Array '" + a->name + "' has invalid size"); return nullptr; }
-        if (symbols.isDeclaredInCurrentScope(a->name)) {
-            addError("Redeclaration of array '" + a->name + "' in same scope"); return nullptr;
-        }
+    case ASTKind::ArrayDecl: {
+        auto* a = static_cast<ArrayDeclAST*>(node);
         llvm::Type* elemTy = llvmType(a->type);
         auto* arrTy  = llvm::ArrayType::get(elemTy, a->size);
-        auto* alloc  = builder.CreateAlloca(arrTy, nullptr, a->name);
-        try { symbols.insert(a->name, astToValueType(a->type), SymbolKind::Array, alloc, a->size); }
-        catch (const std::runtime_error& e) { addError(e.what()); }
+        auto* alloc  = scopedAlloca(arrTy, a->name.str());
+        setLocal(a->slot, alloc, astToValueType(a->type));
         return alloc;
     }
 
     // ── Array access ───────────────────────────────────────────
-    if (auto* arr = dynamic_cast<ArrayAccessAST*>(node)) {
-        const Symbol* sym = symbols.lookup(arr->name);
-        if (!sym) { addError("Use of undeclared array '" + arr->name + "'"); return nullptr; }
-        if (sym->kind != SymbolKind::Array) { addError("'" + arr->name + "' is not an array"); return nullptr; }
-        auto* idx    = generate(arr->index.get()); if (!idx) return nullptr;
+    case ASTKind::ArrayAccess: {
+        auto* arr = static_cast<ArrayAccessAST*>(node);
+        const Local* a = local(arr->slot);
+        if (!a) return internalError("unbound array");
+        auto* idx    = generate(arr->index); if (!idx) return nullptr;
         idx = coerce(idx, llvm::Type::getInt32Ty(context));
-        auto* alloca = llvm::cast<llvm::AllocaInst>(sym->value);
-        auto* arrTy  = alloca->getAllocatedType();
+        auto* arrTy  = llvm::cast<llvm::AllocaInst>(a->value)->getAllocatedType();
         auto* zero   = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
-        auto* gep    = builder.CreateGEP(arrTy, sym->value, {zero, idx}, arr->name + ".gep");
-        return builder.CreateLoad(llvmType(sym->type), gep, arr->name + ".load");
+        auto* gep    = builder.CreateGEP(arrTy, a->value, {zero, idx}, llvm::Twine(arr->name.str()) + ".gep");
+        return builder.CreateLoad(llvmType(a->type), gep, llvm::Twine(arr->name.str()) + ".load");
     }
 
     // ── Array assign ───────────────────────────────────────────
-    if (auto* aa = dynamic_cast<ArrayAssignAST*>(node)) {
-        const Symbol* sym = symbols.lookup(aa->name);
-        if (!sym) { addError("Assignment to undeclared array '" + aa->name + "'"); return nullptr; }
-        if (sym->kind != SymbolKind::Array) { addError("'" + aa->name + "' is not an array"); return nullptr; }
-        auto* idx = generate(aa->index.get()); if (!idx) return nullptr;
+    case ASTKind::ArrayAssign: {
+        auto* aa = static_cast<ArrayAssignAST*>(node);
+        const Local* a = local(aa->slot);
+        if (!a) return internalError("unbound array");
+        auto* idx = generate(aa->index); if (!idx) return nullptr;
         idx = coerce(idx, llvm::Type::getInt32Ty(context));
-        auto* val = generate(aa->expr.get());  if (!val) return nullptr;
-        val = coerce(val, llvmType(sym->type));
-        auto* alloca = llvm::cast<llvm::AllocaInst>(sym->value);
-        auto* arrTy  = alloca->getAllocatedType();
+        auto* val = generate(aa->expr);  if (!val) return nullptr;
+        val = coerce(val, llvmType(a->type));
+        auto* arrTy  = llvm::cast<llvm::AllocaInst>(a->value)->getAllocatedType();
         auto* zero   = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 0);
-        auto* gep    = builder.CreateGEP(arrTy, sym->value, {zero, idx}, aa->name + ".gep");
+        auto* gep    = builder.CreateGEP(arrTy, a->value, {zero, idx}, llvm::Twine(aa->name.str()) + ".gep");
         builder.CreateStore(val, gep);
         return val;
     }
 
-    // ── Binary operators ───────────────────────────────────────
-    if (auto* bin = dynamic_cast<BinaryAST*>(node)) {
-        auto* lhs = generate(bin->lhs.get());
-        auto* rhs = generate(bin->rhs.get());
-        if (!lhs || !rhs) return nullptr;
-        if (lhs->getType()->isPointerTy())
-            lhs = builder.CreateLoad(llvm::Type::getInt32Ty(context), lhs);
-        if (rhs->getType()->isPointerTy())
-            rhs = builder.CreateLoad(llvm::Type::getInt32Ty(context), rhs);
-        auto [l, r] = promoteToCommon(lhs, rhs);
-        bool isFloat = l->getType()->isDoubleTy();
-        if (bin->op == "+")  return isFloat ? builder.CreateFAdd(l,r,"fadd") : builder.CreateAdd(l,r,"add");
-        if (bin->op == "-")  return isFloat ? builder.CreateFSub(l,r,"fsub") : builder.CreateSub(l,r,"sub");
-        if (bin->op == "*")  return isFloat ? builder.CreateFMul(l,r,"fmul") : builder.CreateMul(l,r,"mul");
-        if (bin->op == "/") {
-            if (!isFloat) {
-                auto* zero  = llvm::ConstantInt::get(l->getType(), 0);
-                auto* isZero = builder.CreateICmpEQ(r, zero, "divzero");
-                auto* safeR  = builder.CreateSelect(isZero,
-                    llvm::ConstantInt::get(l->getType(), 1), r, "safe_div");
-                return builder.CreateSDiv(l, safeR, "div");
-            }
-            return builder.CreateFDiv(l, r, "fdiv");
-        }
-        if (bin->op == "<")  return isFloat ? builder.CreateFCmpOLT(l,r,"flt") : builder.CreateICmpSLT(l,r,"lt");
-        if (bin->op == ">")  return isFloat ? builder.CreateFCmpOGT(l,r,"fgt") : builder.CreateICmpSGT(l,r,"gt");
-        if (bin->op == "<=") return isFloat ? builder.CreateFCmpOLE(l,r,"fle") : builder.CreateICmpSLE(l,r,"le");
-        if (bin->op == ">=") return isFloat ? builder.CreateFCmpOGE(l,r,"fge") : builder.CreateICmpSGE(l,r,"ge");
-        if (bin->op == "==") return isFloat ? builder.CreateFCmpOEQ(l,r,"feq") : builder.CreateICmpEQ(l,r,"eq");
-        if (bin->op == "!=") return isFloat ? builder.CreateFCmpONE(l,r,"fne") : builder.CreateICmpNE(l,r,"ne");
-        addError("Unknown binary operator '" + bin->op + "'");
-        return nullptr;
-    }
-
-    // ── Logical operators (short-circuit) ─────────────────────
-    if (auto* log = dynamic_cast<LogicalAST*>(node)) {
-        if (log->op == "&&") {
-            auto* fn      = builder.GetInsertBlock()->getParent();
-            auto* lhsBB   = builder.GetInsertBlock();
-            auto* rhsBB   = llvm::BasicBlock::Create(context, "and.rhs",   fn);
-            auto* mergeBB = llvm::BasicBlock::Create(context, "and.merge", fn);
-            auto* lhsVal  = toBool(generate(log->lhs.get())); if (!lhsVal) return nullptr;
-            builder.CreateCondBr(lhsVal, rhsBB, mergeBB);
-            lhsBB = builder.GetInsertBlock();
-            builder.SetInsertPoint(rhsBB);
-            auto* rhsVal = toBool(generate(log->rhs.get())); if (!rhsVal) return nullptr;
-            auto* rhsEnd = builder.GetInsertBlock();
-            builder.CreateBr(mergeBB);
-            builder.SetInsertPoint(mergeBB);
-            auto* phi = builder.CreatePHI(llvm::Type::getInt1Ty(context), 2);
-            phi->addIncoming(llvm::ConstantInt::getFalse(context), lhsBB);
-            phi->addIncoming(rhsVal, rhsEnd);
-            return phi;
-        }
-        if (log->op == "||") {
-            auto* fn      = builder.GetInsertBlock()->getParent();
-            auto* lhsBB   = builder.GetInsertBlock();
-            auto* rhsBB   = llvm::BasicBlock::Create(context, "or.rhs",   fn);
-            auto* mergeBB = llvm::BasicBlock::Create(context, "or.merge", fn);
-            auto* lhsVal  = toBool(generate(log->lhs.get())); if (!lhsVal) return nullptr;
-            builder.CreateCondBr(lhsVal, mergeBB, rhsBB);
-            lhsBB = builder.GetInsertBlock();
-            builder.SetInsertPoint(rhsBB);
-            auto* rhsVal = toBool(generate(log->rhs.get())); if (!rhsVal) return nullptr;
-            auto* rhsEnd = builder.GetInsertBlock();
-            builder.CreateBr(mergeBB);
-            builder.SetInsertPoint(mergeBB);
-            auto* phi = builder.CreatePHI(llvm::Type::getInt1Ty(context), 2);
-            phi->addIncoming(llvm::ConstantInt::getTrue(context), lhsBB);
-            phi->addIncoming(rhsVal, rhsEnd);
-            return phi;
-        }
-        auto* lhs = generate(log->lhs.get());
-        auto* rhs = generate(log->rhs.get());
-        if (!lhs || !rhs) return nullptr;
-        auto [l, r] = promoteToCommon(lhs, rhs);
-        if (log->op == "==") return builder.CreateICmpEQ(l, r);
-        if (log->op == "!=") return builder.CreateICmpNE(l, r);
-        addError("Unknown logical operator '" + log->op + "'");
-        return nullptr;
-    }
-
-    // ── Unary operators ────────────────────────────────────────
-    if (auto* u = dynamic_cast<UnaryAST*>(node)) {
-        auto* operand = generate(u->operand.get()); if (!operand) return nullptr;
-        if (u->op == "-") {
-            operand = coerce(operand, llvm::Type::getInt32Ty(context));
-            return builder.CreateNeg(operand, "neg");
-        }
-        if (u->op == "!") {
-            auto* b = toBool(operand); if (!b) return nullptr;
-            return builder.CreateNot(b, "not");
-        }
-        addError("Unknown unary operator '" + u->op + "'");
-        return nullptr;
-    }
+    // ── Operators ──────────────────────────────────────────────
+    case ASTKind::Binary:
+    case ASTKind::Logical:
+    case ASTKind::Unary:
+        return operators(node);
 
     // ── Return ─────────────────────────────────────────────────
-    if (auto* ret = dynamic_cast<ReturnAST*>(node)) {
+    case ASTKind::Return: {
+        auto* ret = static_cast<ReturnAST*>(node);
         auto* fn    = builder.GetInsertBlock()->getParent();
         auto* retTy = fn->getReturnType();
         llvm::Value* val = nullptr;
         if (ret->expr) {
-            val = generate(ret->expr.get()); if (!val) return nullptr;
+            val = generate(ret->expr); if (!val) return nullptr;
             val = coerce(val, retTy);
         } else {
-            if (retTy->isVoidTy())    return builder.CreateRetVoid();
+            if (retTy->isVoidTy())    { endLifetimes(0); return builder.CreateRetVoid(); }
             if (retTy->isDoubleTy())  val = llvm::ConstantFP::get(retTy, 0.0);
             else                      val = llvm::ConstantInt::get(retTy, 0);
         }
+        endLifetimes(0);
         return builder.CreateRet(val);
     }
 
     // ── Break / Continue ───────────────────────────────────────
-    if (dynamic_cast<BreakAST*>(node)) {
-        if (breakStack.empty()) { addError("'break' outside loop"); return nullptr; }
+    case ASTKind::Break: {
+        if (breakStack.empty()) return internalError("'break' outside loop");
+        endLifetimes(loopScopes.back());
         return builder.CreateBr(breakStack.back());
     }
-    if (dynamic_cast<ContinueAST*>(node)) {
-        if (continueStack.empty()) { addError("'continue' outside loop"); return nullptr; }
+    case ASTKind::Continue: {
+        if (continueStack.empty()) return internalError("'continue' outside loop");
+        endLifetimes(loopScopes.back());
         return builder.CreateBr(continueStack.back());
     }
 
     // ── Post-increment ─────────────────────────────────────────
-    if (auto* inc = dynamic_cast<PostIncAST*>(node)) {
-        Symbol* sym = symbols.lookup(inc->name);
-        if (!sym) { addError("Use of undeclared variable '" + inc->name + "' in '++'"); return nullptr; }
-        llvm::Type* ty   = llvmType(sym->type);
-        auto* old        = builder.CreateLoad(ty, sym->value, inc->name);
+    case ASTKind::PostInc: {
+        auto* inc = static_cast<PostIncAST*>(node);
+        const Local* v = local(inc->slot);
+        if (!v) return internalError("unbound variable");
+        llvm::Type* ty   = llvmType(v->type);
+        auto* old        = builder.CreateLoad(ty, v->value, inc->name.str());
         llvm::Value* one = ty->isDoubleTy()
                            ? (llvm::Value*)llvm::ConstantFP::get(ty, 1.0)
                            : (llvm::Value*)llvm::ConstantInt::get(ty, 1);
         auto* incremented = ty->isDoubleTy()
                             ? builder.CreateFAdd(old, one, "finc")
-                            : builder.CreateAdd(old, one, "inc");
-        builder.CreateStore(incremented, sym->value);
+                            : intArith(llvm::Instruction::Add, old, one, "inc");
+        builder.CreateStore(incremented, v->value);
         return old;
     }
 
     // ── Program ────────────────────────────────────────────────
-    if (auto* prog = dynamic_cast<ProgramAST*>(node)) {
+    case ASTKind::Program: {
+        auto* prog = static_cast<ProgramAST*>(node);
         for (auto& item : prog->topLevel)
-            generate(item.get());
+            generate(item);
+        if (opts.lean) {
+            std::string errStr;
+            llvm::raw_string_ostream errStream(errStr);
+            if (llvm::verifyModule(*module, &errStream))
+                addError("LLVM IR verify failed: " + errStream.str());
+        }
         return nullptr;
     }
 
+    case ASTKind::Prototype:
+        break;   // only reached through FunctionAST
+    }
+
     addError(std::string("Unhandled AST node type: ") + typeid(*node).name());
     return nullptr;
 }
 
+// ══════════════════════════════════════════════════════════════
+//  Operator trees
+// ══════════════════════════════════════════════════════════════
+// Post-order over Binary/Logical/Unary nodes with the instructions and
+// blocks created in the order a recursive walk would create them:
+// '&&' and '||' make their blocks before their left operand, the
+// others emit after both operands.  Other operands go through
+// generate().  A null operand abandons the whole tree.
+
+llvm::Value* CodeGen::operators(AST* root) {
+    const size_t frameBase = opFrames.size(), valueBase = opValues.size();
+    auto pop = [&] { llvm::Value* v = opValues.back(); opValues.pop_back(); return v; };
+    auto fail = [&]() -> llvm::Value* {
+        opFrames.resize(frameBase);
+        opValues.resize(valueBase);
+        return nullptr;
+    };
+    opFrames.push_back({root});
+    while (opFrames.size() > frameBase) {
+        OpFrame f = opFrames.back();
+        opFrames.pop_back();
+        AST* node = f.node;
+        if (!isOperatorNode(node)) {
+            llvm::Value* v = generate(node);
+            if (!v) return fail();
+            opValues.push_back(v);
+            continue;
+        }
+
+        // ── Unary ─────────────────────────────────────────────
+        if (auto* u = ast_cast<UnaryAST>(node)) {
+            if (f.stage == 0) {
+                opFrames.push_back({node, 1});
+                opFrames.push_back({u->operand});
+                continue;
+            }
+            llvm::Value* operand = pop();
+            if (u->op == UnOp::Neg) {
+                operand = coerce(operand, llvm::Type::getInt32Ty(context));
+                opValues.push_back(intArith(llvm::Instruction::Sub,
+                                            llvm::ConstantInt::get(operand->getType(), 0), operand, "neg"));
+                continue;
+            }
+            auto* b = toBool(operand);
+            if (!b) return fail();
+            opValues.push_back(builder.CreateNot(b, "not"));
+            continue;
+        }
+
+        // ── Short-circuit && / || ─────────────────────────────
+        auto* log = ast_cast<LogicalAST>(node);
+        if (log && (log->op == BinOp::And || log->op == BinOp::Or)) {
+            bool isAnd = log->op == BinOp::And;
+            if (f.stage == 0) {
+                auto* fn  = builder.GetInsertBlock()->getParent();
+                f.rhsBB   = llvm::BasicBlock::Create(context, isAnd ? "and.rhs"   : "or.rhs",   fn);
+                f.mergeBB = llvm::BasicBlock::Create(context, isAnd ? "and.merge" : "or.merge", fn);
+                f.stage   = 1;
+                opFrames.push_back(f);
+                opFrames.push_back({log->lhs});
+                continue;
+            }
+            if (f.stage == 1) {
+                auto* lhsVal = toBool(pop());
+                if (!lhsVal) return fail();
+                if (isAnd) builder.CreateCondBr(lhsVal, f.rhsBB, f.mergeBB);
+                else       builder.CreateCondBr(lhsVal, f.mergeBB, f.rhsBB);
+                f.lhsBB = builder.GetInsertBlock();
+                builder.SetInsertPoint(f.rhsBB);
+                f.stage = 2;
+                opFrames.push_back(f);
+                opFrames.push_back({log->rhs});
+                continue;
+            }
+            auto* rhsVal = toBool(pop());
+            if (!rhsVal) return fail();
+            auto* rhsEnd = builder.GetInsertBlock();
+            builder.CreateBr(f.mergeBB);
+            builder.SetInsertPoint(f.mergeBB);
+            auto* phi = builder.CreatePHI(llvm::Type::getInt1Ty(context), 2);
+            phi->addIncoming(isAnd ? llvm::ConstantInt::getFalse(context)
+                                   : llvm::ConstantInt::getTrue(context), f.lhsBB);
+            phi->addIncoming(rhsVal, rhsEnd);
+            opValues.push_back(phi);
+            continue;
+        }
+
+        // ── Arithmetic, comparisons, == / != ──────────────────
+        auto* bin = ast_cast<BinaryAST>(node);
+        if (f.stage == 0) {
+            opFrames.push_back({node, 1});
+            opFrames.push_back({bin ? bin->rhs : log->rhs});
+            opFrames.push_back({bin ? bin->lhs : log->lhs});
+            continue;
+        }
+        llvm::Value* rhs = pop();
+        llvm::Value* lhs = pop();
+        if (log) {
+            auto [l, r] = promoteToCommon(lhs, rhs);
+            bool isFloat = l->getType()->isDoubleTy();
+            if (log->op == BinOp::Eq)
+                opValues.push_back(isFloat ? builder.CreateFCmpOEQ(l, r) : builder.CreateICmpEQ(l, r));
+            else if (log->op == BinOp::Ne)
+                opValues.push_back(isFloat ? builder.CreateFCmpONE(l, r) : builder.CreateICmpNE(l, r));
+            else {
+                internalError("logical operator");
+                return fail();
+            }
+            continue;
+        }
+        if (lhs->getType()->isPointerTy())
+            lhs = builder.CreateLoad(llvm::Type::getInt32Ty(context), lhs);
+        if (rhs->getType()->isPointerTy())
+            rhs = builder.CreateLoad(llvm::Type::getInt32Ty(context), rhs);
+        opValues.push_back(binaryOp(bin->op, lhs, rhs));
+        if (!opValues.back()) return fail();
+    }
+    llvm::Value* v = opValues.back();
+    opValues.resize(valueBase);
+    return v;
+}
+
+llvm::Value* CodeGen::binaryOp(BinOp op, llvm::Value* lhs, llvm::Value* rhs) {
+    auto [l, r] = promoteToCommon(lhs, rhs);
+    bool isFloat = l->getType()->isDoubleTy();
+    switch (op) {
+    case BinOp::Add:
+        if (!isFloat) return intArith(llvm::Instruction::Add,l,r,"add");
+        if (auto* fma = fusedMulAdd(l, r, false)) return fma;
+        return builder.CreateFAdd(l,r,"fadd");
+    case BinOp::Sub:
+        if (!isFloat) return intArith(llvm::Instruction::Sub,l,r,"sub");
+        if (auto* fma = fusedMulAdd(l, r, true)) return fma;
+        return builder.CreateFSub(l,r,"fsub");
+    case BinOp::Mul: return isFloat ? builder.CreateFMul(l,r,"fmul") : intArith(llvm::Instruction::Mul,l,r,"mul");
+    case BinOp::Div: return isFloat ? builder.CreateFDiv(l,r,"fdiv") : intDiv(l,r);
+    case BinOp::Lt:  return isFloat ? builder.CreateFCmpOLT(l,r,"flt") : builder.CreateICmpSLT(l,r,"lt");
+    case BinOp::Gt:  return isFloat ? builder.CreateFCmpOGT(l,r,"fgt") : builder.CreateICmpSGT(l,r,"gt");
+    case BinOp::Le:  return isFloat ? builder.CreateFCmpOLE(l,r,"fle") : builder.CreateICmpSLE(l,r,"le");
+    case BinOp::Ge:  return isFloat ? builder.CreateFCmpOGE(l,r,"fge") : builder.CreateICmpSGE(l,r,"ge");
+    case BinOp::Eq:  return isFloat ? builder.CreateFCmpOEQ(l,r,"feq") : builder.CreateICmpEQ(l,r,"eq");
+    case BinOp::Ne:  return isFloat ? builder.CreateFCmpONE(l,r,"fne") : builder.CreateICmpNE(l,r,"ne");
+    case BinOp::And:
+    case BinOp::Or:
+        break;   // LogicalAST only
+    }
+    return internalError("binary operator");
+}
+
 // ── toBool ────────────────────────────────────────────────────
 llvm::Value* CodeGen::toBool(llvm::Value* v) {
     if (!v) return nullptr;
@@ -941,17 +1161,65 @@ llvm::Value* CodeGen::toBool(llvm::Value* v) {
     if (v->getType()->isDoubleTy())
         return builder.CreateFCmpONE(v,
             llvm::ConstantFP::get(v->getType(), 0.0), "fbool");
-    addError("toBool: unsupported type");
-    return nullptr;
+    return internalError("toBool: unsupported type");
 }
 
-void CodeGen::dumpToFile(const std::string& filename) {
+bool CodeGen::dumpToFile(const std::string& filename) {
     std::error_code EC;
     llvm::raw_fd_ostream out(filename, EC);
-    if (EC) { addError("Cannot write '" + filename + "': " + EC.message()); return; }
+    if (EC) { addError("Cannot write '" + filename + "': " + EC.message()); return false; }
     module->print(out, nullptr);
+    return true;
 }
 
 void CodeGen::dump() {
     module->print(llvm::outs(), nullptr);
 }
+
+llvm::orc::ThreadSafeModule CodeGen::takeModule() {
+    return llvm::orc::ThreadSafeModule(std::move(module),
+                                       llvm::orc::ThreadSafeContext(std::move(ownedContext)));
+}
+
+bool CodeGen::writeBitcode(const std::string& filename) {
+    std::error_code EC;
+    llvm::raw_fd_ostream out(filename, EC);
+    if (EC) { addError("Cannot write '" + filename + "': " + EC.message()); return false; }
+    llvm::WriteBitcodeToFile(*module, out);
+    return true;
+}
+
+bool CodeGen::emitFile(const std::string& filename, bool assembly) {
+    if (!targetMachine) { addError("No target machine to emit '" + filename + "'"); return false; }
+    std::error_code EC;
+    llvm::raw_fd_ostream out(filename, EC);
+    if (EC) { addError("Cannot write '" + filename + "': " + EC.message()); return false; }
+    llvm::legacy::PassManager PM;
+    if (targetMachine->addPassesToEmitFile(PM, out, nullptr,
+            assembly ? llvm::CGFT_AssemblyFile : llvm::CGFT_ObjectFile)) {
+        addError("Target cannot emit '" + filename + "'");
+        return false;
+    }
+    PM.run(*module);
+    return true;
+}
+
+bool CodeGen::emitObjects(const std::vector<std::string>& filenames) {
+    if (filenames.size() == 1) return emitFile(filenames[0], false);
+    if (!targetMachine) { addError("No target machine to emit objects"); return false; }
+    std::vector<std::unique_ptr<llvm::raw_fd_ostream>> files;
+    std::vector<llvm::raw_pwrite_stream*>              streams;
+    for (const auto& filename : filenames) {
+        std::error_code EC;
+        files.push_back(std::make_unique<llvm::raw_fd_ostream>(filename, EC));
+        if (EC) { addError("Cannot write '" + filename + "': " + EC.message()); return false; }
+        streams.push_back(files.back().get());
+    }
+    const llvm::TargetMachine& tm = *targetMachine;
+    llvm::splitCodeGen(*module, streams, {}, [&tm] {
+        return std::unique_ptr<llvm::TargetMachine>(tm.getTarget().createTargetMachine(
+            tm.getTargetTriple().str(), tm.getTargetCPU(), tm.getTargetFeatureString(),
+            tm.Options, tm.getRelocationModel(), tm.getCodeModel(), tm.getOptLevel()));
+    });
+    return true;
+}
@@ -0,0 +1,154 @@
+#include "codegen/JIT.h"
+#include "llvm/Support/CrashRecoveryContext.h"
+#include <algorithm>
+#include <csignal>
+#include <vector>
+
+// CrashRecoveryContext's handlers run on the crashing stack, which a
+// runaway recursion has just used up: give SIGSEGV/SIGBUS an alternate
+// one so deep recursion is reported (139) instead of killing the compiler.
+static void enableCrashRecovery() {
+    llvm::CrashRecoveryContext::Enable();
+    static std::vector<char> altStack(1 << 16);
+    stack_t ss{};
+    ss.ss_sp   = altStack.data();
+    ss.ss_size = altStack.size();
+    sigaltstack(&ss, nullptr);
+    for (int sig : {SIGSEGV, SIGBUS}) {
+        struct sigaction sa;
+        if (sigaction(sig, nullptr, &sa) == 0) {
+            sa.sa_flags |= SA_ONSTACK;
+            sigaction(sig, &sa, nullptr);
+        }
+    }
+}
+
+JIT::JIT(const llvm::TargetMachine& target, OptLevel level, bool lazy)
+    : jtmb(target.getTargetTriple()), level(level), lazy(lazy)
+{
+    jtmb.setCPU(target.getTargetCPU().str());
+    jtmb.getFeatures() = llvm::SubtargetFeatures(target.getTargetFeatureString());
+    jtmb.setRelocationModel(target.getRelocationModel());
+    jtmb.setCodeGenOptLevel(level == OptLevel::O0 ? llvm::CodeGenOpt::None
+                          : level == OptLevel::O1 ? llvm::CodeGenOpt::Less
+                          : level == OptLevel::O2 ? llvm::CodeGenOpt::Default
+                          :                         llvm::CodeGenOpt::Aggressive);
+
+    if (lazy) {
+        auto tm = jtmb.createTargetMachine();
+        if (!tm) { error = llvm::toString(tm.takeError()); return; }
+        optTarget = std::move(*tm);
+        if (!createLazy()) return;
+    } else {
+        auto created = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(jtmb).create();
+        if (created) jit = std::move(*created);
+        else         error = llvm::toString(created.takeError());
+    }
+
+    static const bool recovery = (enableCrashRecovery(), true);
+    (void)recovery;
+}
+
+// Each partition the compile-on-demand layer hands down (one function,
+// on its first call) is optimized here, then timed until the compile
+// layer has turned it into an object.
+bool JIT::createLazy() {
+    auto created = llvm::orc::LLLazyJITBuilder().setJITTargetMachineBuilder(jtmb).create();
+    if (!created) {
+        error = llvm::toString(created.takeError());
+        return false;
+    }
+    jit = std::move(*created);
+    jit->getIRTransformLayer().setTransform(
+        [this](llvm::orc::ThreadSafeModule tsm, llvm::orc::MaterializationResponsibility& r)
+            -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+            Pending p{{}, std::chrono::steady_clock::now()};
+            tsm.withModuleDo([&](llvm::Module& m) {
+                for (auto& fn : m) {
+                    if (fn.isDeclaration()) continue;
+                    if (!p.names.empty()) p.names += ", ";
+                    p.names += fn.getName().str();
+                }
+                if (optimizeLazily && !p.names.empty())
+                    CodeGen::runPipeline(m, level, optTarget.get());
+            });
+            if (!p.names.empty()) pending[&r] = std::move(p);
+            return tsm;
+        });
+    jit->getIRCompileLayer().setNotifyCompiled(
+        [this](llvm::orc::MaterializationResponsibility& r, llvm::orc::ThreadSafeModule) {
+            auto it = pending.find(&r);
+            if (it == pending.end()) return;
+            std::chrono::duration<double, std::milli> ms =
+                std::chrono::steady_clock::now() - it->second.start;
+            stats.compiled.push_back({std::move(it->second.names), ms.count()});
+            pending.erase(it);
+        });
+    return true;
+}
+
+int JIT::run(llvm::orc::ThreadSafeModule module, bool optimized) {
+    if (!jit && !(lazy && createLazy())) return -1;
+    auto fail = [&](llvm::Error e) {
+        error = llvm::toString(std::move(e));
+        return -1;
+    };
+    // The module's code lives until 'tracker' removes it, so the next
+    // module can define main() again.  The compile-on-demand layer keeps
+    // function bodies in a dylib of its own, out of the tracker's reach,
+    // so a lazy JIT is dropped whole instead and rebuilt for the next run.
+    auto tracker = jit->getMainJITDylib().createResourceTracker();
+    struct Remove {
+        JIT&                          self;
+        llvm::orc::ResourceTrackerSP& rt;
+        ~Remove() {
+            llvm::consumeError(rt->remove());
+            rt = nullptr;
+            if (self.lazy) self.jit.reset();
+        }
+    } remove{*this, tracker};
+
+    // main() is called through a pointer of its own return type: int as
+    // is, float converted as a cast to int would (clamped), void as 0.
+    llvm::Type* retTy = nullptr;
+    module.withModuleDo([&](llvm::Module& m) {
+        if (llvm::Function* f = m.getFunction("main"); f && !f->isDeclaration())
+            retTy = f->getReturnType();
+    });
+    if (retTy && !retTy->isIntegerTy(32) && !retTy->isDoubleTy() && !retTy->isVoidTy()) {
+        error = "main() must return int, float or void";
+        return -1;
+    }
+
+    if (lazy) {
+        // Only main's stub exists after lookup(); bodies follow on demand.
+        stats = LazyStats{};
+        optimizeLazily = !optimized;
+        module.withModuleDo([&](llvm::Module& m) {
+            for (auto& fn : m) stats.functions += !fn.isDeclaration();
+        });
+        auto& cod = static_cast<llvm::orc::LLLazyJIT&>(*jit).getCompileOnDemandLayer();
+        if (auto e = cod.add(tracker, std::move(module))) return fail(std::move(e));
+    } else if (auto e = jit->addIRModule(tracker, std::move(module))) {
+        return fail(std::move(e));
+    }
+    auto sym = jit->lookup("main");
+    if (!sym) return fail(sym.takeError());
+
+    // Its parameters, if any, are as undefined as a native binary's would be.
+    auto addr = sym->getAddress();
+    int result = 0;
+    auto callMain = [&] {
+        if (retTy->isDoubleTy()) {
+            double v = reinterpret_cast<double (*)()>(addr)();
+            result = v == v ? (int)std::clamp(v, -2147483648.0, 2147483647.0) : 0;
+        } else if (retTy->isVoidTy()) {
+            reinterpret_cast<void (*)()>(addr)();
+        } else {
+            result = reinterpret_cast<int (*)()>(addr)();
+        }
+    };
+    llvm::CrashRecoveryContext crc;
+    if (!crc.RunSafely(callMain)) return crc.RetCode & 0xff;
+    return result & 0xff;
+}
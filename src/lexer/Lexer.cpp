@@ -1,7 +1,9 @@
 #include "lexer/Lexer.h"
+#include "lexer/CharScan.h"
+#include "lexer/Keywords.h"
 #include <cctype>
 
-Lexer::Lexer(const std::string& s, bool kc)
+Lexer::Lexer(std::string_view s, bool kc)
     : src(s), pos(0), line(1), keepComments(kc) {}
 
 char Lexer::peek() const {
@@ -9,39 +11,43 @@ char Lexer::peek() const {
     return src[pos + 1];
 }
 
-char Lexer::getChar() {
-    if (pos >= src.size()) return '\0';
-    char c = src[pos++];
-    if (c == '\n') line++;
-    return c;
-}
-
 void Lexer::addError(const std::string& msg) {
     errors.push_back({line, msg});
 }
 
-std::vector<Token> Lexer::tokenize() {
-    std::vector<Token> tokens;
+Token Lexer::token(TokenType t, size_t start, int tokLine) const {
+    return {t, src.substr(start, pos - start), tokLine};
+}
 
+// ── Scan one token ────────────────────────────────────────────
+// Skips whitespace (and comments when keepComments is false) and returns
+// the next token; returns EOF_TOK forever once the source is exhausted.
+Token Lexer::next() {
     while (pos < src.size()) {
         char c = src[pos];
 
         // ── Whitespace ────────────────────────────────────────
-        if (c == '\n') { line++; pos++; continue; }
-        if (isspace(c)) { pos++; continue; }
+        if (scalar_scan::isSpace((unsigned char)c)) {
+            pos = simd_scan::skipWhitespace(src.data() + pos, src.data() + src.size(), line)
+                  - src.data();
+            continue;
+        }
 
         int tokLine = line;
 
         // ── Line comment  // ──────────────────────────────────
         if (c == '/' && peek() == '/') {
             pos += 2;
-            std::string body;
-            while (pos < src.size() && src[pos] != '\n')
-                body += src[pos++];
-            size_t start = body.find_first_not_of(' ');
-            if (start != std::string::npos) body = body.substr(start);
-            if (keepComments)
-                tokens.push_back({TokenType::LINE_COMMENT, body, tokLine});
+            size_t start = pos;
+            pos = simd_scan::findLineEnd(src.data() + pos, src.data() + src.size())
+                  - src.data();
+            if (keepComments) {
+                std::string_view body = src.substr(start, pos - start);
+                size_t s = body.find_first_not_of(' ');
+                if (s != std::string_view::npos) body.remove_prefix(s);
+                ++comments;
+                return {TokenType::LINE_COMMENT, body, tokLine};
+            }
             continue;
         }
 
@@ -49,119 +55,100 @@ std::vector<Token> Lexer::tokenize() {
         if (c == '/' && peek() == '*') {
             pos += 2;
             int startLine = line;
-            std::string body;
-            bool closed = false;
-            while (pos + 1 < src.size()) {
-                if (src[pos] == '\n') { line++; body += '\n'; pos++; continue; }
-                if (src[pos] == '*' && src[pos+1] == '/') {
-                    pos += 2; closed = true; break;
-                }
-                body += src[pos++];
-            }
-            if (!closed)
+            size_t start = pos, end = pos;
+            const char* base = src.data();
+            const char* stop = simd_scan::findBlockCommentEnd(base + pos, base + src.size(), line);
+            pos = end = stop - base;
+            if (pos + 1 < src.size()) {
+                pos += 2;
+            } else {
                 addError("Unterminated block comment (opened at line "
                          + std::to_string(startLine) + ")");
-            size_t s = body.find_first_not_of(" \t\n");
-            size_t e = body.find_last_not_of(" \t\n");
-            if (s != std::string::npos) body = body.substr(s, e - s + 1);
-            else body = "";
-            if (keepComments)
-                tokens.push_back({TokenType::BLOCK_COMMENT, body, tokLine});
+            }
+            if (keepComments) {
+                std::string_view body = src.substr(start, end - start);
+                size_t s = body.find_first_not_of(" \t\n");
+                size_t e = body.find_last_not_of(" \t\n");
+                if (s != std::string_view::npos) body = body.substr(s, e - s + 1);
+                else body = body.substr(0, 0);
+                ++comments;
+                return {TokenType::BLOCK_COMMENT, body, tokLine};
+            }
             continue;
         }
 
         // ── Identifiers / keywords ────────────────────────────
         if (isalpha(c) || c == '_') {
-            std::string id;
+            size_t start = pos;
             while (pos < src.size() && (isalnum(src[pos]) || src[pos] == '_'))
-                id += src[pos++];
-            TokenType tt;
-            if      (id == "int")      tt = TokenType::INT;
-            else if (id == "float")    tt = TokenType::FLOAT;
-            else if (id == "void")     tt = TokenType::VOID;
-            else if (id == "return")   tt = TokenType::RETURN;
-            else if (id == "if")       tt = TokenType::IF;
-            else if (id == "else")     tt = TokenType::ELSE;
-            else if (id == "while")    tt = TokenType::WHILE;
-            else if (id == "for")      tt = TokenType::FOR;
-            else if (id == "break")    tt = TokenType::BREAK;
-            else if (id == "continue") tt = TokenType::CONTINUE;
-            else if (id == "class")    tt = TokenType::CLASS;
-            else if (id == "new")      tt = TokenType::NEW;
-            else if (id == "this")     tt = TokenType::THIS;
-            else if (id == "public")   tt = TokenType::PUBLIC;
-            else if (id == "private")  tt = TokenType::PRIVATE;
-            else                       tt = TokenType::IDENT;
-            tokens.push_back({tt, id, tokLine});
-            continue;
+                pos++;
+            std::string_view id = src.substr(start, pos - start);
+            TokenType kind = lookupKeyword(id);
+            if (kind != TokenType::IDENT) return {kind, id, tokLine};
+            return {kind, id, tokLine, Atom::intern(id)};
         }
 
         // ── Numbers ───────────────────────────────────────────
         if (isdigit(c)) {
-            std::string num;
+            size_t start = pos;
             bool isFloat = false;
             while (pos < src.size() && (isdigit(src[pos]) || src[pos] == '.')) {
                 if (src[pos] == '.') { if (isFloat) break; isFloat = true; }
-                num += src[pos++];
+                pos++;
             }
-            tokens.push_back({isFloat ? TokenType::FLOAT_VAL : TokenType::NUMBER,
-                               num, tokLine});
-            continue;
+            return {isFloat ? TokenType::FLOAT_VAL : TokenType::NUMBER,
+                    src.substr(start, pos - start), tokLine};
         }
 
         // ── Operators & punctuation ───────────────────────────
+        size_t start = pos;
         switch (c) {
             case '+':
-                if (peek() == '+') { getChar(); getChar();
-                    tokens.push_back({TokenType::INC, "++", tokLine}); }
-                else { tokens.push_back({TokenType::PLUS, "+", tokLine}); pos++; }
-                continue;
+                if (peek() == '+') { pos += 2;
+                    return token(TokenType::INC, start, tokLine); }
+                pos++; return token(TokenType::PLUS, start, tokLine);
             case '-':
-                tokens.push_back({TokenType::MINUS, "-", tokLine}); pos++; continue;
+                pos++; return token(TokenType::MINUS, start, tokLine);
             case '*':
-                tokens.push_back({TokenType::MUL, "*", tokLine}); pos++; continue;
+                pos++; return token(TokenType::MUL, start, tokLine);
             case '/':
-                tokens.push_back({TokenType::DIV, "/", tokLine}); pos++; continue;
+                pos++; return token(TokenType::DIV, start, tokLine);
             case '.':
-                tokens.push_back({TokenType::DOT, ".", tokLine}); pos++; continue;
+                pos++; return token(TokenType::DOT, start, tokLine);
             case '=':
-                if (peek() == '=') { getChar(); getChar();
-                    tokens.push_back({TokenType::EQ, "==", tokLine}); }
-                else { tokens.push_back({TokenType::ASSIGN, "=", tokLine}); pos++; }
-                continue;
+                if (peek() == '=') { pos += 2;
+                    return token(TokenType::EQ, start, tokLine); }
+                pos++; return token(TokenType::ASSIGN, start, tokLine);
             case '!':
-                if (peek() == '=') { getChar(); getChar();
-                    tokens.push_back({TokenType::NEQ, "!=", tokLine}); }
-                else { tokens.push_back({TokenType::NOT, "!", tokLine}); pos++; }
-                continue;
+                if (peek() == '=') { pos += 2;
+                    return token(TokenType::NEQ, start, tokLine); }
+                pos++; return token(TokenType::NOT, start, tokLine);
             case '<':
-                if (peek() == '=') { getChar(); getChar();
-                    tokens.push_back({TokenType::LE, "<=", tokLine}); }
-                else { tokens.push_back({TokenType::LT, "<", tokLine}); pos++; }
-                continue;
+                if (peek() == '=') { pos += 2;
+                    return token(TokenType::LE, start, tokLine); }
+                pos++; return token(TokenType::LT, start, tokLine);
             case '>':
-                if (peek() == '=') { getChar(); getChar();
-                    tokens.push_back({TokenType::GE, ">=", tokLine}); }
-                else { tokens.push_back({TokenType::GT, ">", tokLine}); pos++; }
-                continue;
+                if (peek() == '=') { pos += 2;
+                    return token(TokenType::GE, start, tokLine); }
+                pos++; return token(TokenType::GT, start, tokLine);
             case '&':
-                if (peek() == '&') { getChar(); getChar();
-                    tokens.push_back({TokenType::AND, "&&", tokLine}); }
-                else { addError("Unknown character '&' — did you mean '&&'?"); pos++; }
+                if (peek() == '&') { pos += 2;
+                    return token(TokenType::AND, start, tokLine); }
+                addError("Unknown character '&' — did you mean '&&'?"); pos++;
                 continue;
             case '|':
-                if (peek() == '|') { getChar(); getChar();
-                    tokens.push_back({TokenType::OR, "||", tokLine}); }
-                else { addError("Unknown character '|' — did you mean '||'?"); pos++; }
+                if (peek() == '|') { pos += 2;
+                    return token(TokenType::OR, start, tokLine); }
+                addError("Unknown character '|' — did you mean '||'?"); pos++;
                 continue;
-            case '(': tokens.push_back({TokenType::LPAREN,   "(", tokLine}); pos++; continue;
-            case ')': tokens.push_back({TokenType::RPAREN,   ")", tokLine}); pos++; continue;
-            case '{': tokens.push_back({TokenType::LBRACE,   "{", tokLine}); pos++; continue;
-            case '}': tokens.push_back({TokenType::RBRACE,   "}", tokLine}); pos++; continue;
-            case '[': tokens.push_back({TokenType::LBRACKET, "[", tokLine}); pos++; continue;
-            case ']': tokens.push_back({TokenType::RBRACKET, "]", tokLine}); pos++; continue;
-            case ';': tokens.push_back({TokenType::SEMI,     ";", tokLine}); pos++; continue;
-            case ',': tokens.push_back({TokenType::COMMA,    ",", tokLine}); pos++; continue;
+            case '(': pos++; return token(TokenType::LPAREN, start, tokLine);
+            case ')': pos++; return token(TokenType::RPAREN, start, tokLine);
+            case '{': pos++; return token(TokenType::LBRACE, start, tokLine);
+            case '}': pos++; return token(TokenType::RBRACE, start, tokLine);
+            case '[': pos++; return token(TokenType::LBRACKET, start, tokLine);
+            case ']': pos++; return token(TokenType::RBRACKET, start, tokLine);
+            case ';': pos++; return token(TokenType::SEMI, start, tokLine);
+            case ',': pos++; return token(TokenType::COMMA, start, tokLine);
             default:
                 addError(std::string("Unknown character '") + c + "'");
                 pos++;
@@ -169,6 +156,5 @@ std::vector<Token> Lexer::tokenize() {
         }
     }
 
-    tokens.push_back({TokenType::EOF_TOK, "", line});
-    return tokens;
+    return {TokenType::EOF_TOK, src.substr(src.size()), line};
 }
@@ -0,0 +1,28 @@
+#include "lexer/TokenStream.h"
+
+TokenStream::TokenStream(Lexer& lexer) : src(lexer.source()) {
+    // Roughly one token per 4 source bytes in typical .mc code.
+    size_t guess = src.size() / 4 + kPadding + 1;
+    types.reserve(guess);
+    offsets.reserve(guess);
+    lengths.reserve(guess);
+    lines.reserve(guess);
+    atoms.reserve(guess);
+
+    Token t;
+    do {
+        t = lexer.next();
+        push(t);
+    } while (t.type != TokenType::EOF_TOK);
+    count = types.size();
+
+    for (size_t i = 0; i < kPadding; ++i) push(t);
+}
+
+void TokenStream::push(const Token& t) {
+    types.push_back(t.type);
+    offsets.push_back((uint32_t)(t.lexeme.data() - src.data()));
+    lengths.push_back((uint32_t)t.lexeme.size());
+    lines.push_back(t.line);
+    atoms.push_back(t.atom);
+}
@@ -8,11 +8,28 @@
 //    • Multi-level optimization  (--O0 / --O1 / --O2 / --O3)
 //    • Auto-correction of syntax errors     (--no-autocorrect to disable)
 //    • Comment preservation through full pipeline
+//    • Lean release builds                  (--release)
+//    • Diagnostics without codegen          (--check)
+//    • Integer overflow / division modes    (--int-semantics=, --div=)
+//    • Fast-math and FP contraction         (--fast-math, --fp-contract=, fast)
+//    • Target-aware optimization            (--target-cpu=, --target-features=, -march=)
+//    • In-process object emission           (--emit=ll|bc|asm|obj|exe)
+//    • Parallel top-level parsing           (--parse-threads=N)
+//    • Parallel split-module code generation (--codegen-threads=N)
+//    • JIT execution, eager or lazy         (--jit, --jit=lazy)
 //
 //  Usage:
-//    ./Quail_Compiler [--debug] [--build] [--O0|--O1|--O2|--O3]
-//                    [--no-autocorrect] [--show-ir-diff] <file.mc>
-//    ./Quail_Compiler --test-all [--build] [--O2] [--testdir d] [--out d]
+//    ./Quail_Compiler [--debug] [--build|--jit[=lazy]] [--emit=kinds] [--O0|--O1|--O2|--O3]
+//                    [--no-autocorrect] [--show-ir-diff] [--release]
+//                    [--int-semantics=wrap|nsw|trap] [--div=safe|unchecked|trap]
+//                    [--fast-math] [--fp-contract=off|on|fast]
+//                    [--target-cpu=cpu] [--target-features=+f,-g] [-march=native]
+//                    [--parse-threads=N] [--codegen-threads=N] <file.mc>
+//    ./Quail_Compiler --check [--parse-threads=N] <file.mc>
+//    ./Quail_Compiler --check --test-all [--parse-threads=N] [--testdir d]
+//    ./Quail_Compiler --test-all [--build|--jit[=lazy]] [--emit=kinds] [--O2] [--release] [--int-semantics=..] [--div=..]
+//                    [--fast-math] [--fp-contract=..] [--target-cpu=..] [-march=native]
+//                    [--parse-threads=N] [--testdir d] [--out d]
 // ============================================================
 
 #include <iostream>
@@ -21,16 +38,24 @@
 #include <iomanip>
 #include <string>
 #include <vector>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <algorithm>
+#include <optional>
 #include <unordered_map>
+#include <thread>
+#include <spawn.h>
 #include <sys/wait.h>
 
-#include "lexer/Lexer.h"
+#include "lexer/TokenStream.h"
 #include "parser/Parser.h"
+#include "semantic/Resolver.h"
+#include "semantic/Checker.h"
 #include "codegen/CodeGen.h"
+#include "codegen/JIT.h"
 #include "autocorrect/AutoCorrector.h"
+#include "utils/SourceBuffer.h"
 
 namespace fs = std::filesystem;
 
@@ -133,7 +158,7 @@ static void printTokenTable(const std::vector<Token>& tokens) {
         else
             cat = std::string(RED)     + "OP/PUNCT" + RESET;
 
-        std::string lex = tk.lexeme;
+        std::string lex(tk.lexeme);
         if (lex.size() > (size_t)(W1 - 2)) lex = lex.substr(0, W1 - 5) + "...";
         std::cout << "| " << std::left << std::setw(W1) << lex
                   << " | " << std::setw(W2) << tokStr(tk.type)
@@ -173,16 +198,21 @@ static void printCommentSummary(const std::vector<Token>& tokens) {
 //  Class registry report
 // ─────────────────────────────────────────────────────────────
 static void printClassRegistry(
-        const std::unordered_map<std::string, ClassInfo>& infos)
+        const std::unordered_map<Atom, ClassInfo>& infos)
 {
     if (infos.empty()) return;
+    std::vector<const ClassInfo*> sorted;
+    for (auto& entry : infos) sorted.push_back(&entry.second);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ClassInfo* a, const ClassInfo* b) { return a->name.str() < b->name.str(); });
     std::cout << "\n" << BOLD << MAGENTA
               << "╔══════════════════════════════════════════════════════════╗\n"
               << "║                   CLASS REGISTRY                        ║\n"
               << "╚══════════════════════════════════════════════════════════╝\n"
               << RESET;
-    for (auto& [name, info] : infos) {
-        std::cout << "\n  " << BOLD << CYAN << "class " << name << RESET << " {\n";
+    for (const ClassInfo* cls : sorted) {
+        const ClassInfo& info = *cls;
+        std::cout << "\n  " << BOLD << CYAN << "class " << info.name << RESET << " {\n";
         if (info.fields.empty())
             std::cout << DIM << "    (no fields)\n" << RESET;
         for (auto& [fn, ft] : info.fields)
@@ -221,7 +251,7 @@ static void printSymbolTable(const std::vector<SymbolLogEntry>& log) {
                 sig += SymbolTable::typeName(e->paramTypes[i]);
             }
             sig += ")";
-            bool isMethod = (e->name.find('_') != std::string::npos);
+            bool isMethod = (e->name.str().find('_') != std::string::npos);
             std::cout << "  " << (isMethod ? MAGENTA : GREEN) << BOLD
                       << (isMethod ? "  mtd " : "  fn  ") << RESET
                       << BOLD << std::left << std::setw(44) << sig << RESET
@@ -238,11 +268,13 @@ static void printSymbolTable(const std::vector<SymbolLogEntry>& log) {
     if (locals.empty()) {
         std::cout << DIM << "    (none)\n" << RESET;
     } else {
-        std::string lastOwner = "\x01";
+        Atom lastOwner;
+        bool first = true;
         for (const auto* e : locals) {
-            if (e->ownerFunction != lastOwner) {
+            if (first || e->ownerFunction != lastOwner) {
+                first     = false;
                 lastOwner = e->ownerFunction;
-                std::string owner = lastOwner.empty() ? "<global>" : lastOwner;
+                std::string owner = lastOwner.empty() ? "<global>" : lastOwner.str();
                 std::cout << "\n  " << YELLOW << BOLD << "  in " << owner << "():\n" << RESET;
             }
             const char* kc =
@@ -325,7 +357,8 @@ static void printOptReport(const OptStats& s, OptLevel level,
     if (showDiff && !irBefore.empty() && !irAfter.empty()) {
         auto split = [](const std::string& src) {
             std::vector<std::string> v; std::istringstream ss(src); std::string l;
-            while (std::getline(ss, l)) v.push_back(l); return v;
+            while (std::getline(ss, l)) v.push_back(l);
+            return v;
         };
         auto bL = split(irBefore), aL = split(irAfter);
         std::cout << "\n" << BOLD << "── IR diff (before → after) ──\n" << RESET
@@ -344,16 +377,43 @@ static void printOptReport(const OptStats& s, OptLevel level,
     }
 }
 
+// ─────────────────────────────────────────────────────────────
+//  Lazy JIT report — what main() actually needed compiled
+// ─────────────────────────────────────────────────────────────
+static void printLazyStats(const JIT::LazyStats& s) {
+    std::cout << "\n" << MAGENTA << BOLD
+              << "╔══════════════════════════════════════════════════════════╗\n"
+              << "║              LAZY JIT REPORT                            ║\n"
+              << "╚══════════════════════════════════════════════════════════╝\n"
+              << RESET << "  Compiled on first call: " << BOLD << s.compiled.size()
+              << RESET << " of " << s.functions << " function(s)\n\n";
+
+    const int W = 40;
+    double total = 0;
+    std::cout << BOLD << std::left << std::setw(W) << "Function" << "First-call compile (ms)\n"
+              << RESET << std::string(W + 23, '-') << "\n";
+    for (const auto& c : s.compiled) {
+        std::cout << std::left << std::setw(W) << c.name
+                  << std::fixed << std::setprecision(3) << c.ms << "\n";
+        total += c.ms;
+    }
+    std::cout << std::string(W + 23, '-') << "\n"
+              << BOLD << std::left << std::setw(W) << "TOTAL"
+              << std::fixed << std::setprecision(3) << total << RESET << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+}
+
 // ─────────────────────────────────────────────────────────────
 //  Error report
 // ─────────────────────────────────────────────────────────────
-static bool reportErrors(const std::string& filename,
+static bool reportErrors(const SourceBuffer&              src,
                          const std::vector<LexError>&     lexErrs,
                          const std::vector<ParseError>&   parseErrs,
                          const std::vector<CodeGenError>& cgErrs)
 {
     bool any = !lexErrs.empty() || !parseErrs.empty() || !cgErrs.empty();
     if (!any) return false;
+    const std::string& filename = src.path();
     std::cerr << "\n" << RED << BOLD
               << "╔══════════════════════════════════════════════════════════╗\n"
               << "║                   COMPILATION ERRORS                    ║\n"
@@ -371,79 +431,175 @@ static bool reportErrors(const std::string& filename,
 // ─────────────────────────────────────────────────────────────
 //  CompileResult
 // ─────────────────────────────────────────────────────────────
+// ── Output kinds (--emit) ─────────────────────────────────────
+enum Emit : unsigned {
+    EmitLL  = 1u << 0,   // <stem>.ll  textual IR (the default)
+    EmitBC  = 1u << 1,   // <stem>.bc  bitcode
+    EmitAsm = 1u << 2,   // <stem>.s   assembly
+    EmitObj = 1u << 3,   // <stem>.o   object file
+    EmitExe = 1u << 4,   // <stem>     linked executable (--build also runs it)
+};
+
 struct CompileResult {
     bool        parseOk      = false;
-    bool        irOk         = false;
+    bool        irOk         = false;   // every requested output was written
     bool        linkOk       = false;
     int         exitCode     = -1;
     int         errorCount   = 0;
-    std::string llPath;
+    std::string outPath;                // the first output written
     std::string binPath;
     int         commentCount = 0;
     int         classCount   = 0;
 };
 
 // ═════════════════════════════════════════════════════════════
-//  compileSinglePass — runs Lex → Parse → CodeGen → (Opt) → IR
+//  Frontend — Lex → Parse → Resolve → Check → CodeGen over one source buffer
+// ═════════════════════════════════════════════════════════════
+// Every stage's results stay alive, so a clean run goes straight on to
+// optimisation and emission without lexing, parsing or generating again.
+struct Frontend {
+    AtomTable                   atoms;       // every name of this compile, freed with it
+    AtomTable::Scope            interning;   // current while the stages below run
+    Lexer                       lexer;
+    TokenStream                 stream;
+    Parser                      parser;
+    std::unique_ptr<ProgramAST> ast;
+    std::unique_ptr<CodeGen>    cg;          // only for programs the checker accepts
+    std::vector<LexError>       lexErrors;
+    std::vector<ParseError>     parseErrors;
+    std::vector<CodeGenError>   cgErrors;    // checker's, else CodeGen's
+    std::vector<SymbolLogEntry> symbolLog;   // the Resolver's, for the symbol dump
+
+    // 'parseThreads' 1 parses serially; 'cgOpts' configures the CodeGen
+    // (lean for --release, integer semantics); 'generate' false stops
+    // after the checker, without an LLVMContext.
+    Frontend(std::string_view src, bool keepComments, unsigned parseThreads,
+             const CodeGenOptions& cgOpts = {}, bool generate = true)
+        : interning(atoms), lexer(src, keepComments), stream(lexer),
+          parser(stream, parseThreads)
+    {
+        ast         = parser.parse();
+        lexErrors   = lexer.getErrors();
+        parseErrors = parser.getErrors();
+        if (lexErrors.empty() && parseErrors.empty() && ast) {
+            Resolver resolver(generate && !cgOpts.lean);
+            resolver.resolve(*ast);
+            symbolLog = resolver.getSymbolLog();
+            Checker checker;
+            checker.check(*ast);
+            for (const auto& e : checker.getErrors()) cgErrors.push_back({e.message});
+            if (cgErrors.empty() && generate) {
+                cg = std::make_unique<CodeGen>(cgOpts);
+                cg->generate(ast.get());
+                cgErrors = cg->getErrors();
+            }
+        }
+        interning.end();
+    }
+
+    bool hasErrors() const {
+        return !lexErrors.empty() || !parseErrors.empty() || !cgErrors.empty();
+    }
+};
+
+// ═════════════════════════════════════════════════════════════
+//  spawn — run a program without a shell
 // ═════════════════════════════════════════════════════════════
-static CompileResult compileSinglePass(const std::string& displayPath,
-                                       const std::string& source,
-                                       const std::string& outDir,
-                                       const std::string& stem,
-                                       bool  debugMode,
-                                       bool  buildBinaries,
-                                       bool  verbose,
-                                       OptLevel optLevel,
-                                       bool showIrDiff)
+// Looks args[0] up on PATH and waits for it.  Returns its exit status,
+// 128 + the signal if one killed it (as a shell reports it), or -1 if it
+// could not be started.  With 'stderrText' its stderr is collected there
+// instead of printed, for the caller to show only if it failed.
+static int spawn(const std::vector<std::string>& args, std::string* stderrText = nullptr) {
+    std::vector<char*> argv;
+    for (const auto& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+
+    std::unique_ptr<FILE, int (*)(FILE*)> errFile(stderrText ? std::tmpfile() : nullptr, std::fclose);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (errFile)
+        posix_spawn_file_actions_adddup2(&actions, fileno(errFile.get()), STDERR_FILENO);
+    pid_t pid;
+    int rc = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) return -1;
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0)
+        if (errno != EINTR) return -1;
+    if (errFile) {
+        std::rewind(errFile.get());
+        char buf[4096];
+        for (size_t n; (n = std::fread(buf, 1, sizeof buf, errFile.get())) > 0;)
+            stderrText->append(buf, n);
+    }
+    if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    return WEXITSTATUS(status);
+}
+
+// ═════════════════════════════════════════════════════════════
+//  finishCompile — reports, (Opt) → emit → (link, run) for a frontend run
+// ═════════════════════════════════════════════════════════════
+static CompileResult finishCompile(const SourceBuffer& source,
+                                   Frontend& fe,
+                                   const std::string& outDir,
+                                   const std::string& stem,
+                                   bool  debugMode,
+                                   unsigned emit,
+                                   bool  buildBinaries,
+                                   JIT*  jit,
+                                   bool  verbose,
+                                   OptLevel optLevel,
+                                   bool showIrDiff,
+                                   bool release)
 {
     CompileResult res;
-    res.llPath  = outDir + "/" + stem + ".ll";
-    res.binPath = outDir + "/" + stem;
-    std::string objPath = outDir + "/" + stem + ".o";
+    // --release prints diagnostics and results only: no token, AST,
+    // symbol or IR dumps (the data behind them was never collected).
+    bool dumps = verbose && !release;
+    const std::string base = outDir + "/" + stem;
+    res.binPath = base;
 
     // ── LEXER ─────────────────────────────────────────────────
-    Lexer lexer(source, true);
-    auto tokens    = lexer.tokenize();
-    auto lexErrors = lexer.getErrors();
-
-    for (const auto& t : tokens)
-        if (t.type == TokenType::LINE_COMMENT || t.type == TokenType::BLOCK_COMMENT)
-            ++res.commentCount;
-
-    if (verbose && debugMode) {
-        std::cout << "\n" << BLUE << BOLD << "[LEXICAL ANALYSIS]\n" << RESET;
-        printTokenTable(tokens);
-        printCommentSummary(tokens);
-        std::cout << "\n";
-    } else if (verbose) {
-        std::cout << "--- [TOKEN STREAM] ---\n";
-        for (const auto& tk : tokens) {
-            if (tk.type == TokenType::LINE_COMMENT)
-                std::cout << DIM << "[COMMENT]    line:" << std::setw(4) << tk.line
-                          << "  // " << tk.lexeme << RESET << "\n";
-            else if (tk.type == TokenType::BLOCK_COMMENT)
-                std::cout << DIM << "[COMMENT]    line:" << std::setw(4) << tk.line
-                          << "  /* " << tk.lexeme.substr(0, 40)
-                          << (tk.lexeme.size() > 40 ? "..." : "") << " */" << RESET << "\n";
-            else
-                std::cout << "[TOKEN] " << std::left << std::setw(12) << tokStr(tk.type)
-                          << "  line:" << std::setw(4) << tk.line
-                          << "  \"" << tk.lexeme << "\"\n";
-            if (tk.type == TokenType::EOF_TOK) break;
+    const TokenStream& stream = fe.stream;
+    res.commentCount = fe.lexer.commentCount();
+
+    if (dumps) {
+        std::vector<Token> tokens;
+        tokens.reserve(stream.size());
+        for (size_t i = 0; i < stream.size(); ++i) tokens.push_back(stream.at(i));
+        if (debugMode) {
+            std::cout << "\n" << BLUE << BOLD << "[LEXICAL ANALYSIS]\n" << RESET;
+            printTokenTable(tokens);
+            printCommentSummary(tokens);
+            std::cout << "\n";
+        } else {
+            std::cout << "--- [TOKEN STREAM] ---\n";
+            for (const auto& tk : tokens) {
+                if (tk.type == TokenType::LINE_COMMENT)
+                    std::cout << DIM << "[COMMENT]    line:" << std::setw(4) << tk.line
+                              << "  // " << tk.lexeme << RESET << "\n";
+                else if (tk.type == TokenType::BLOCK_COMMENT)
+                    std::cout << DIM << "[COMMENT]    line:" << std::setw(4) << tk.line
+                              << "  /* " << tk.lexeme.substr(0, 40)
+                              << (tk.lexeme.size() > 40 ? "..." : "") << " */" << RESET << "\n";
+                else
+                    std::cout << "[TOKEN] " << std::left << std::setw(12) << tokStr(tk.type)
+                              << "  line:" << std::setw(4) << tk.line
+                              << "  \"" << tk.lexeme << "\"\n";
+                if (tk.type == TokenType::EOF_TOK) break;
+            }
+            std::cout << "  " << DIM << "(" << res.commentCount
+                      << " comment token(s) preserved)" << RESET << "\n"
+                      << "----------------------\n\n";
         }
-        std::cout << "  " << DIM << "(" << res.commentCount
-                  << " comment token(s) preserved)" << RESET << "\n"
-                  << "----------------------\n\n";
     }
 
     // ── PARSER ────────────────────────────────────────────────
-    Parser parser(tokens);
-    auto ast         = parser.parse();
-    auto parseErrors = parser.getErrors();
-
-    if (!lexErrors.empty() || !parseErrors.empty()) {
-        res.errorCount = (int)lexErrors.size() + (int)parseErrors.size();
-        if (verbose) reportErrors(displayPath, lexErrors, parseErrors, {});
+    const auto& ast = fe.ast;
+    if (!fe.lexErrors.empty() || !fe.parseErrors.empty()) {
+        res.errorCount = (int)fe.lexErrors.size() + (int)fe.parseErrors.size();
+        if (verbose) reportErrors(source, fe.lexErrors, fe.parseErrors, {});
         return res;
     }
     if (!ast) {
@@ -452,7 +608,7 @@ static CompileResult compileSinglePass(const std::string& displayPath,
     }
     res.parseOk = true;
 
-    if (verbose) {
+    if (dumps) {
         if (debugMode) {
             std::cout << BLUE << BOLD << "[AST — with OOP nodes]\n" << RESET;
             ast->print(0);
@@ -465,20 +621,17 @@ static CompileResult compileSinglePass(const std::string& displayPath,
     }
 
     // ── CODEGEN ───────────────────────────────────────────────
-    CodeGen cg;
-    cg.generate(ast.get());
-    auto cgErrors = cg.getErrors();
-
-    if (!cgErrors.empty()) {
-        res.errorCount = (int)cgErrors.size();
-        if (verbose) reportErrors(displayPath, {}, {}, cgErrors);
+    if (!fe.cgErrors.empty()) {
+        res.errorCount = (int)fe.cgErrors.size();
+        if (verbose) reportErrors(source, {}, {}, fe.cgErrors);
         return res;
     }
+    CodeGen& cg = *fe.cg;
 
     res.classCount = (int)cg.getClassInfos().size();
 
     // ── REPORTS ───────────────────────────────────────────────
-    if (verbose) {
+    if (dumps) {
         if (!cg.getClassInfos().empty()) {
             printClassRegistry(cg.getClassInfos());
         }
@@ -487,15 +640,21 @@ static CompileResult compileSinglePass(const std::string& displayPath,
                   << "║                   SYMBOL TABLE                          ║\n"
                   << "╚══════════════════════════════════════════════════════════╝\n"
                   << RESET;
-        printSymbolTable(cg.getSymbolLog());
+        printSymbolTable(fe.symbolLog);
     }
 
     // ── OPTIMIZATION ──────────────────────────────────────────
+    // A lazy JIT with no files to write optimizes each function itself,
+    // when it is first called.
+    bool deferOpt = jit && jit->isLazy() && !emit;
     std::string irBefore;
-    if (optLevel != OptLevel::O0 && verbose)
+    if (optLevel != OptLevel::O0 && !deferOpt && dumps)
         irBefore = cg.getIRString();
 
-    if (optLevel != OptLevel::O0) {
+    if (optLevel != OptLevel::O0 && deferOpt) {
+        if (verbose)
+            std::cout << DIM << "\n  (Optimization deferred: each function on its first call)\n" << RESET;
+    } else if (optLevel != OptLevel::O0) {
         if (verbose) {
             const char* lvl = optLevel == OptLevel::O1 ? "O1" :
                               optLevel == OptLevel::O2 ? "O2" : "O3";
@@ -503,7 +662,7 @@ static CompileResult compileSinglePass(const std::string& displayPath,
                       << "── Running optimizer (" << lvl << ") ──\n" << RESET;
         }
         cg.optimize(optLevel);
-        if (verbose) {
+        if (dumps) {
             std::string irAfter = cg.getIRString();
             printOptReport(cg.getOptStats(), optLevel, irBefore, irAfter, showIrDiff);
         }
@@ -511,44 +670,96 @@ static CompileResult compileSinglePass(const std::string& displayPath,
         std::cout << DIM << "\n  (Optimization disabled: --O0)\n" << RESET;
     }
 
-    // ── EMIT IR ───────────────────────────────────────────────
-    cg.dumpToFile(res.llPath);
-    res.irOk = fs::exists(res.llPath) && fs::file_size(res.llPath) > 0;
-
-    if (verbose && res.irOk) {
+    if (dumps) {
         std::cout << "\n--- [LLVM IR"
-                  << (optLevel != OptLevel::O0 ? " (optimized)" : "") << "] ---\n";
+                  << (optLevel != OptLevel::O0 && !deferOpt ? " (optimized)" : "") << "] ---\n";
         cg.dump();
-        std::cout << YELLOW << "\n→ IR written to: " << res.llPath << RESET << "\n";
     }
 
-    // ── BUILD (optional) ──────────────────────────────────────
-    if (buildBinaries && res.irOk) {
-        std::string llcCmd   = "llc "   + res.llPath + " -filetype=obj -o " + objPath + " 2>/dev/null";
-        std::string clangCmd = "clang " + objPath    + " -o " + res.binPath            + " 2>/dev/null";
+    // ── EMIT ──────────────────────────────────────────────────
+    // Straight from the in-memory module, IR first (the code generator
+    // rewrites it).  An executable is linked from an object file, which
+    // is removed again unless --emit asked for it.
+    res.irOk = true;
+    auto wrote = [&](bool ok, const std::string& path, const char* what) {
+        res.irOk = res.irOk && ok;
+        if (!ok) return;
+        if (res.outPath.empty()) res.outPath = path;
+        if (verbose) std::cout << YELLOW << "→ " << what << " written to: " << path << RESET << "\n";
+    };
+    if (verbose) std::cout << "\n";
+    if (emit & EmitLL)  wrote(cg.dumpToFile(base + ".ll"), base + ".ll", "IR");
+    if (emit & EmitBC)  wrote(cg.writeBitcode(base + ".bc"), base + ".bc", "Bitcode");
+    if (emit & EmitAsm) wrote(cg.emitFile(base + ".s", true), base + ".s", "Assembly");
+    // --emit=obj writes one object; an executable alone is linked from
+    // --codegen-threads partial objects, generated in parallel.
+    const std::string objPath = base + ".o";
+    std::vector<std::string> objPaths{objPath};
+    bool objOk = false;
+    if (emit & (EmitObj | EmitExe)) {
+        unsigned parts = (emit & EmitObj) ? 1 : cg.getOptions().codegenThreads;
+        if (parts > 1) {
+            objPaths.clear();
+            for (unsigned i = 0; i < parts; ++i)
+                objPaths.push_back(base + "." + std::to_string(i) + ".o");
+        }
+        objOk = cg.emitObjects(objPaths);
+        if (emit & EmitObj) wrote(objOk, objPath, "Object");
+        else                res.irOk = res.irOk && objOk;
+    }
+    if (!res.irOk && verbose)
+        for (const auto& e : cg.getErrors())
+            std::cerr << RED << "[EMIT] " << e.message << RESET << "\n";
+
+    // ── LINK / RUN ────────────────────────────────────────────
+    if ((emit & EmitExe) && objOk) {
+        std::vector<std::string> link{"cc"};
+        link.insert(link.end(), objPaths.begin(), objPaths.end());
+        link.insert(link.end(), {"-o", res.binPath});
         if (verbose) {
-            std::cout << "\n" << BOLD << "Building...\n" << RESET
-                      << "  $ " << llcCmd << "\n";
+            std::cout << "\n" << BOLD << "Linking...\n" << RESET << "  $";
+            for (const auto& a : link) std::cout << " " << a;
+            std::cout << "\n";
         }
-        bool llcOk   = (std::system(llcCmd.c_str())   == 0);
-        if (verbose) std::cout << "  $ " << clangCmd << "\n";
-        bool clangOk = llcOk && (std::system(clangCmd.c_str()) == 0);
-        res.linkOk = clangOk;
+        std::string linkErrors;
+        int linkRc = spawn(link, &linkErrors);
+        res.linkOk = linkRc == 0;
+        if (!(emit & EmitObj))
+            for (const auto& p : objPaths) fs::remove(p);
         if (res.linkOk) {
+            if (res.outPath.empty()) res.outPath = res.binPath;
             if (verbose)
                 std::cout << GREEN << "→ Executable: " << res.binPath << RESET << "\n\n";
-            int raw = std::system(res.binPath.c_str());
-            res.exitCode = WEXITSTATUS(raw);
-            if (verbose)
-                std::cout << YELLOW << "Exit code: " << res.exitCode << RESET << "\n";
+            if (buildBinaries) {
+                res.exitCode = spawn({res.binPath});
+                if (verbose)
+                    std::cout << YELLOW << "Exit code: " << res.exitCode << RESET << "\n";
+            }
         } else if (verbose) {
-            std::cerr << RED << "[BUILD] llc/clang failed.\n" << RESET;
+            if (linkRc < 0)
+                std::cerr << RED << "[BUILD] could not run cc.\n" << RESET;
+            else
+                std::cerr << RED << "[BUILD] linking with cc failed:\n" << RESET << linkErrors;
         }
-    } else if (!buildBinaries && verbose) {
+    } else if (!(emit & EmitExe) && !jit && verbose) {
         std::cout << "\n" << BOLD << "Next steps:\n" << RESET
-                  << "  llc "   << res.llPath << " -filetype=obj -o " << objPath << "\n"
-                  << "  clang " << objPath    << " -o " << res.binPath << "\n"
-                  << "  " << res.binPath << " ; echo $?\n";
+                  << "  --build       link and run the program\n"
+                  << "  --jit         run it in-process, no files\n"
+                  << "  --emit=exe    link it only (also ll, bc, asm, obj)\n";
+    }
+
+    // ── JIT (optional) ────────────────────────────────────────
+    // Last: the JIT takes the module over.
+    if (jit && res.irOk) {
+        if (verbose) std::cout << "\n" << BOLD << "Running main() on the JIT...\n" << RESET;
+        res.exitCode = jit->run(cg.takeModule(), !deferOpt);
+        res.linkOk   = res.exitCode >= 0;
+        if (!res.linkOk && verbose)
+            std::cerr << RED << "[JIT] " << jit->getError() << RESET << "\n";
+        else if (verbose)
+            std::cout << YELLOW << "Exit code: " << res.exitCode << RESET << "\n";
+        if (res.linkOk && verbose && jit->isLazy())
+            printLazyStats(jit->getLazyStats());
     }
 
     return res;
@@ -560,46 +771,56 @@ static CompileResult compileSinglePass(const std::string& displayPath,
 static CompileResult compileOne(const std::string& srcPath,
                                 const std::string& outDir,
                                 bool debugMode,
+                                unsigned emit,
                                 bool buildBinaries,
+                                JIT* jit,
                                 bool verbose,
                                 OptLevel optLevel,
                                 bool autoCorrect,
-                                bool showIrDiff)
+                                bool showIrDiff,
+                                unsigned parseThreads,
+                                const CodeGenOptions& cgOpts)
 {
+    const bool release = cgOpts.lean;
     fs::path p(srcPath);
     std::string stem = p.stem().string();
 
-    std::ifstream file(srcPath);
-    if (!file.is_open()) {
+    // Loaded once; both lexer passes, diagnostics and the auto-corrector
+    // all read from this buffer.
+    SourceBuffer source(srcPath);
+    if (!source.isOpen()) {
         if (verbose)
             std::cerr << RED << "Cannot open: " << srcPath << RESET << "\n";
         return {};
     }
-    std::stringstream buf; buf << file.rdbuf();
-    std::string source = buf.str();
 
-    // ── Pass 1: error detection (comment-stripped) ─────────────
-    Lexer lx1(source, false);
-    auto toks1     = lx1.tokenize();
-    auto lexErrs1  = lx1.getErrors();
-    Parser px1(toks1);
-    auto ast1       = px1.parse();
-    auto parseErrs1 = px1.getErrors();
-    std::vector<CodeGenError> cgErrs1;
-    if (lexErrs1.empty() && parseErrs1.empty() && ast1) {
-        CodeGen cg1;
-        cg1.generate(ast1.get());
-        cgErrs1 = cg1.getErrors();
+    // ── Pass 1: full frontend ──────────────────────────────────
+    // A clean file is finished from these results directly.  --release
+    // lexes without comments from the start.
+    Frontend fe(source.view(), !release, parseThreads, cgOpts);
+    if (!fe.hasErrors())
+        return finishCompile(source, fe, outDir, stem,
+                             debugMode, emit, buildBinaries, jit, verbose, optLevel, showIrDiff, release);
+
+    // ── Error detection (comment-stripped) ─────────────────────
+    // The auto-corrector works from the comment-stripped diagnostics, so
+    // files with errors get a second, comment-free frontend run (checked,
+    // not generated).  If that one is clean the errors come from comment
+    // placement alone and are reported as they are.
+    std::optional<Frontend> stripped;
+    if (!release) {
+        stripped.emplace(source.view(), false, parseThreads, CodeGenOptions{}, false);
+        if (!stripped->hasErrors())
+            return finishCompile(source, fe, outDir, stem,
+                                 debugMode, emit, buildBinaries, jit, verbose, optLevel, showIrDiff, release);
     }
-
-    bool hasErrors = !lexErrs1.empty() || !parseErrs1.empty() || !cgErrs1.empty();
-
-    if (!hasErrors)
-        return compileSinglePass(srcPath, source, outDir, stem,
-                                 debugMode, buildBinaries, verbose, optLevel, showIrDiff);
+    const Frontend& probe  = stripped ? *stripped : fe;
+    const auto& lexErrs1   = probe.lexErrors;
+    const auto& parseErrs1 = probe.parseErrors;
+    const auto& cgErrs1    = probe.cgErrors;
 
     if (!autoCorrect) {
-        if (verbose) reportErrors(srcPath, lexErrs1, parseErrs1, cgErrs1);
+        if (verbose) reportErrors(source, lexErrs1, parseErrs1, cgErrs1);
         CompileResult bad;
         bad.errorCount = (int)lexErrs1.size() + (int)parseErrs1.size() + (int)cgErrs1.size();
         return bad;
@@ -608,7 +829,7 @@ static CompileResult compileOne(const std::string& srcPath,
     // ── Auto-correction phase ──────────────────────────────────
     if (verbose) {
         std::cout << BOLD << "\n══ PASS 1: Errors detected ══\n" << RESET;
-        reportErrors(srcPath, lexErrs1, parseErrs1, cgErrs1);
+        reportErrors(source, lexErrs1, parseErrs1, cgErrs1);
         std::cout << "\n" << YELLOW << BOLD
                   << "══ AUTO-CORRECTION PHASE ══\n" << RESET
                   << "  Attempting to fix "
@@ -617,7 +838,8 @@ static CompileResult compileOne(const std::string& srcPath,
     }
 
     AutoCorrector corrector(source, lexErrs1, parseErrs1, cgErrs1);
-    std::string corrected = corrector.correct();
+    std::string corrPath = outDir + "/" + stem + "_corrected.mc";
+    SourceBuffer corrected(corrPath, corrector.correct());
     const auto& fixes     = corrector.getCorrections();
 
     if (verbose) {
@@ -642,26 +864,28 @@ static CompileResult compileOne(const std::string& srcPath,
     }
 
     // Write corrected file
-    std::string corrPath = outDir + "/" + stem + "_corrected.mc";
-    { std::ofstream o(corrPath); if (o) o << corrected; }
+    { std::ofstream o(corrPath); if (o) o << corrected.view(); }
 
     if (verbose) {
         std::cout << "\n" << YELLOW << "  Corrected file: " << corrPath << RESET << "\n";
         std::cout << "\n" << BLUE << BOLD << "══ CORRECTED SOURCE ══\n" << RESET;
-        std::istringstream crs(corrected); std::string cln; int ln = 1;
-        while (std::getline(crs, cln)) {
+        for (int ln = 1; ln <= corrected.lineCount(); ++ln) {
             bool isFix = false;
             for (const auto& f : fixes) if (f.line == ln) { isFix = true; break; }
             std::cout << (isFix ? std::string(GREEN) : std::string(DIM))
-                      << std::setw(4) << ln++ << RESET << " │ " << cln << "\n";
+                      << std::setw(4) << ln << RESET << " │ " << corrected.lineText(ln) << "\n";
         }
     }
 
     if (verbose)
         std::cout << "\n" << BOLD << "══ PASS 2: Compiling corrected source ══\n" << RESET;
 
-    auto r2 = compileSinglePass(corrPath, corrected, outDir, stem + "_corrected",
-                                debugMode, buildBinaries, verbose, optLevel, showIrDiff);
+    // Only re-run the frontend if the corrector actually changed the text.
+    std::unique_ptr<Frontend> fe2;
+    if (corrected.view() != source.view())
+        fe2 = std::make_unique<Frontend>(corrected.view(), !release, parseThreads, cgOpts);
+    auto r2 = finishCompile(corrected, fe2 ? *fe2 : fe, outDir, stem + "_corrected",
+                            debugMode, emit, buildBinaries, jit, verbose, optLevel, showIrDiff, release);
 
     if (r2.parseOk && r2.irOk && verbose)
         std::cout << "\n" << GREEN << BOLD
@@ -671,28 +895,75 @@ static CompileResult compileOne(const std::string& srcPath,
                   << RESET
                   << "  Original : " << srcPath  << "\n"
                   << "  Corrected: " << corrPath << "\n"
-                  << "  IR       : " << r2.llPath << "\n\n";
+                  << "  Output   : " << r2.outPath << "\n\n";
     return r2;
 }
 
+// ═════════════════════════════════════════════════════════════
+//  checkOne — --check: diagnostics only
+// ═════════════════════════════════════════════════════════════
+// Lex, parse, resolve and check; no IR and no LLVMContext.  Reports the
+// same errors a --no-autocorrect compile would, comment-stripped ones
+// first.  Returns the process exit code.
+static int checkOne(const std::string& srcPath, unsigned parseThreads) {
+    SourceBuffer source(srcPath);
+    if (!source.isOpen()) {
+        std::cerr << RED << "Cannot open: " << srcPath << RESET << "\n";
+        return 1;
+    }
+    Frontend fe(source.view(), true, parseThreads, {}, false);
+    if (!fe.hasErrors()) {
+        std::cout << GREEN << srcPath << ": no errors" << RESET << "\n";
+        return 0;
+    }
+    Frontend stripped(source.view(), false, parseThreads, {}, false);
+    const Frontend& shown = stripped.hasErrors() ? stripped : fe;
+    reportErrors(source, shown.lexErrors, shown.parseErrors, shown.cgErrors);
+    return 1;
+}
+
 // ═════════════════════════════════════════════════════════════
 //  Batch test suite
 // ═════════════════════════════════════════════════════════════
-static void runTestSuite(const std::string& testDir,
-                         const std::string& outDir,
-                         bool buildBinaries,
-                         bool autoCorrect,
-                         OptLevel optLevel)
-{
+// The suite's sources, in name order.
+static std::vector<std::string> testFiles(const std::string& testDir) {
     std::vector<std::string> files;
     for (auto& e : fs::directory_iterator(testDir))
         if (e.path().extension() == ".mc")
             files.push_back(e.path().string());
     std::sort(files.begin(), files.end());
-    if (files.empty()) {
+    if (files.empty())
         std::cout << YELLOW << "No .mc files in: " << testDir << RESET << "\n";
-        return;
-    }
+    return files;
+}
+
+// --test-all --check: checkOne over every file, then a tally.
+static void checkTestSuite(const std::string& testDir, unsigned parseThreads) {
+    std::vector<std::string> files = testFiles(testDir);
+    if (files.empty()) return;
+    int clean = 0;
+    for (auto& srcPath : files)
+        if (checkOne(srcPath, parseThreads) == 0) ++clean;
+    int failed = (int)files.size() - clean;
+    std::cout << "\n" << BOLD << "Results: " << GREEN << clean << " clean" << RESET
+              << "  /  " << (failed ? std::string(RED) : std::string(GREEN))
+              << failed << " with errors" << RESET
+              << "  out of " << files.size() << "\n\n";
+}
+
+static void runTestSuite(const std::string& testDir,
+                         const std::string& outDir,
+                         unsigned emit,
+                         bool buildBinaries,
+                         JIT* jit,
+                         bool autoCorrect,
+                         OptLevel optLevel,
+                         unsigned parseThreads,
+                         const CodeGenOptions& cgOpts)
+{
+    const bool release = cgOpts.lean;
+    std::vector<std::string> files = testFiles(testDir);
+    if (files.empty()) return;
     fs::create_directories(outDir);
 
     const char* lvl = optLevel == OptLevel::O0 ? "O0" :
@@ -708,7 +979,8 @@ static void runTestSuite(const std::string& testDir,
               << "  Out dir  : " << outDir   << "\n"
               << "  Tests    : " << files.size() << "\n"
               << "  Opt      : " << lvl          << "\n"
-              << "  AutoFix  : " << (autoCorrect ? "yes" : "no") << "\n\n";
+              << "  AutoFix  : " << (autoCorrect ? "yes" : "no") << "\n"
+              << (release ? "  Release  : yes (comments not kept)\n" : "") << "\n";
 
     const int NW = 36, SW = 8;
     std::cout << BOLD << std::left
@@ -719,27 +991,30 @@ static void runTestSuite(const std::string& testDir,
               << std::setw(6)  << "Cls"
               << std::setw(10) << "Link"
               << std::setw(SW) << "Exit"
-              << "IR path\n" << RESET
+              << "Output\n" << RESET
               << std::string(NW + SW * 3 + 6 + 6 + 10 + 30, '-') << "\n";
 
     int passed = 0, failed = 0;
     for (auto& srcPath : files) {
         std::string name = fs::path(srcPath).filename().string();
         std::cout << std::left << std::setw(NW) << name << std::flush;
-        CompileResult r = compileOne(srcPath, outDir, false, buildBinaries, false,
-                                     optLevel, autoCorrect, false);
+        CompileResult r = compileOne(srcPath, outDir, false, emit, buildBinaries, jit, false,
+                                     optLevel, autoCorrect, false, parseThreads, cgOpts);
         std::cout << (r.parseOk ? std::string(GREEN)+"OK  "+RESET : std::string(RED)+"FAIL"+RESET) << "    ";
         std::cout << (r.irOk    ? std::string(GREEN)+"OK  "+RESET : std::string(RED)+"FAIL"+RESET) << "    ";
         std::cout << DIM << std::setw(6) << r.commentCount
                         << std::setw(6) << r.classCount << RESET;
-        if (buildBinaries)
+        if (jit)
+            std::cout << (r.linkOk ? std::string(GREEN)+"jit       "+RESET
+                                   : std::string(RED)  +"FAIL      "+RESET);
+        else if (emit & EmitExe)
             std::cout << (r.linkOk ? std::string(GREEN)+"linked    "+RESET
                                    : std::string(RED)  +"FAIL      "+RESET);
         else
             std::cout << std::setw(10) << "skipped";
         if (r.exitCode >= 0) std::cout << YELLOW << std::setw(SW) << r.exitCode << RESET;
         else                 std::cout << std::setw(SW) << "n/a";
-        if (r.irOk) std::cout << r.llPath;
+        if (r.irOk) std::cout << r.outPath;
         if (r.errorCount > 0)
             std::cout << "  " << RED << "(" << r.errorCount << " err)" << RESET;
         std::cout << "\n";
@@ -762,7 +1037,14 @@ int main(int argc, char* argv[]) {
     bool        testAll     = false;
     bool        autoCorrect = true;
     bool        showIrDiff  = false;
+    bool        release     = false;
+    bool        checkOnly   = false;
+    unsigned    emit        = 0;
+    bool        useJit      = false;
+    bool        lazyJit     = false;
     OptLevel    optLevel    = OptLevel::O2;
+    unsigned    parseThreads = std::max(1u, std::thread::hardware_concurrency());
+    CodeGenOptions cgOpts;
     std::string testDir     = "test";
     std::string outDir      = "out";
     std::string inputFile;
@@ -771,23 +1053,139 @@ int main(int argc, char* argv[]) {
         std::string a = argv[i];
         if      (a == "--debug")          debugMode   = true;
         else if (a == "--build")          buildBin    = true;
+        else if (a == "--jit")            useJit      = true;
+        else if (a.rfind("--jit=", 0) == 0) {
+            std::string v = a.substr(6);
+            if      (v == "eager") lazyJit = false;
+            else if (v == "lazy")  lazyJit = true;
+            else {
+                std::cerr << RED << "Unknown --jit mode: " << v
+                          << " (expected eager or lazy)" << RESET << "\n";
+                return 1;
+            }
+            useJit = true;
+        }
         else if (a == "--test-all")       testAll     = true;
         else if (a == "--no-autocorrect") autoCorrect = false;
         else if (a == "--show-ir-diff")   showIrDiff  = true;
+        else if (a == "--release")        release     = true;
+        else if (a == "--check")          checkOnly   = true;
         else if (a == "--O0")             optLevel    = OptLevel::O0;
         else if (a == "--O1")             optLevel    = OptLevel::O1;
         else if (a == "--O2")             optLevel    = OptLevel::O2;
         else if (a == "--O3")             optLevel    = OptLevel::O3;
+        else if (a.rfind("--int-semantics=", 0) == 0) {
+            std::string v = a.substr(16);
+            if      (v == "wrap") cgOpts.intSemantics = IntSemantics::Wrap;
+            else if (v == "nsw")  cgOpts.intSemantics = IntSemantics::NSW;
+            else if (v == "trap") cgOpts.intSemantics = IntSemantics::Trap;
+            else {
+                std::cerr << RED << "Unknown --int-semantics: " << v
+                          << " (expected wrap, nsw or trap)" << RESET << "\n";
+                return 1;
+            }
+        }
+        else if (a.rfind("--div=", 0) == 0) {
+            std::string v = a.substr(6);
+            if      (v == "safe")      cgOpts.div = DivSemantics::Safe;
+            else if (v == "unchecked") cgOpts.div = DivSemantics::Unchecked;
+            else if (v == "trap")      cgOpts.div = DivSemantics::Trap;
+            else {
+                std::cerr << RED << "Unknown --div: " << v
+                          << " (expected safe, unchecked or trap)" << RESET << "\n";
+                return 1;
+            }
+        }
+        else if (a == "--fast-math" || a == "-ffast-math") cgOpts.fastMath = true;
+        else if (a.rfind("--fp-contract=", 0) == 0 || a.rfind("-ffp-contract=", 0) == 0) {
+            std::string v = a.substr(a.find('=') + 1);
+            if      (v == "off")  cgOpts.fpContract = FPContract::Off;
+            else if (v == "on")   cgOpts.fpContract = FPContract::On;
+            else if (v == "fast") cgOpts.fpContract = FPContract::Fast;
+            else {
+                std::cerr << RED << "Unknown --fp-contract: " << v
+                          << " (expected off, on or fast)" << RESET << "\n";
+                return 1;
+            }
+        }
+        else if (a.rfind("--target-cpu=", 0) == 0)      cgOpts.targetCPU      = a.substr(13);
+        else if (a.rfind("--target-features=", 0) == 0) cgOpts.targetFeatures = a.substr(18);
+        else if (a.rfind("-march=", 0) == 0)            cgOpts.targetCPU      = a.substr(7);
+        else if (a.rfind("--parse-threads=", 0) == 0) {
+            std::string v = a.substr(16);
+            char* end = nullptr;
+            unsigned long n = std::strtoul(v.c_str(), &end, 10);
+            if (v.empty() || *end || n < 1 || n > 256) {
+                std::cerr << RED << "Invalid --parse-threads: " << v
+                          << " (expected 1 to 256)" << RESET << "\n";
+                return 1;
+            }
+            parseThreads = (unsigned)n;
+        }
+        else if (a.rfind("--codegen-threads=", 0) == 0) {
+            std::string v = a.substr(18);
+            char* end = nullptr;
+            unsigned long n = std::strtoul(v.c_str(), &end, 10);
+            if (v.empty() || *end || n < 1 || n > 256) {
+                std::cerr << RED << "Invalid --codegen-threads: " << v
+                          << " (expected 1 to 256)" << RESET << "\n";
+                return 1;
+            }
+            cgOpts.codegenThreads = (unsigned)n;
+        }
+        else if (a.rfind("--emit=", 0) == 0) {
+            std::stringstream kinds(a.substr(7));
+            for (std::string k; std::getline(kinds, k, ',');) {
+                if      (k == "ll")  emit |= EmitLL;
+                else if (k == "bc")  emit |= EmitBC;
+                else if (k == "asm") emit |= EmitAsm;
+                else if (k == "obj") emit |= EmitObj;
+                else if (k == "exe") emit |= EmitExe;
+                else {
+                    std::cerr << RED << "Unknown --emit kind: " << k
+                              << " (expected ll, bc, asm, obj or exe)" << RESET << "\n";
+                    return 1;
+                }
+            }
+        }
         else if (a == "--testdir" && i+1 < argc) testDir = argv[++i];
         else if (a == "--out"     && i+1 < argc) outDir  = argv[++i];
         else if (a[0] != '-')             inputFile   = a;
     }
 
+    cgOpts.lean = release;
+    if (!emit && !useJit) emit = EmitLL;   // --jit alone writes nothing
+    if (buildBin) emit |= EmitExe;
+
+    // One TargetMachine for the whole run, every file and recompile
+    // included; an unknown CPU or feature is rejected here, before any
+    // file is compiled.  --jit sets up its one JIT for the same target.
+    std::unique_ptr<JIT> jit;
+    if (!checkOnly) {
+        std::string error;
+        cgOpts.target = CodeGen::createTargetMachine(cgOpts, error);
+        if (!cgOpts.target) {
+            std::cerr << RED << error << RESET << "\n";
+            return 1;
+        }
+        if (useJit) jit = std::make_unique<JIT>(*cgOpts.target, optLevel, lazyJit);
+        if (jit && !jit->getError().empty()) {
+            std::cerr << RED << "[JIT] " << jit->getError() << RESET << "\n";
+            return 1;
+        }
+    }
+
+    if (testAll && checkOnly) {
+        checkTestSuite(testDir, parseThreads);
+        return 0;
+    }
     if (testAll) {
-        runTestSuite(testDir, outDir, buildBin, autoCorrect, optLevel);
+        runTestSuite(testDir, outDir, emit, buildBin, jit.get(), autoCorrect, optLevel, parseThreads, cgOpts);
         return 0;
     }
 
+    if (checkOnly && !inputFile.empty()) return checkOne(inputFile, parseThreads);
+
     if (inputFile.empty()) {
         std::cout << BOLD << "Quail Compiler v3.0  (OOP edition)\n\n" << RESET
                   << "Usage:\n"
@@ -796,12 +1194,41 @@ int main(int argc, char* argv[]) {
                   << "OPTIONS:\n"
                   << "  --debug           Token table + full AST\n"
                   << "  --build           Compile to native binary and run\n"
+                  << "  --jit             Run main() in-process on an ORC JIT (no files)\n"
+                  << "  --jit=lazy        ... compiling each function on its first call\n"
+                  << "  --emit=ll,bc,asm,obj,exe\n"
+                  << "                    Files to write (default: ll); all are\n"
+                  << "                    produced in-process, exe is linked by cc\n"
+                  << "  --parse-threads=N Parse large files' top level on N threads\n"
+                  << "                    (default: all cores; 1 parses serially)\n"
+                  << "  --codegen-threads=N\n"
+                  << "                    Split the module, generate an exe's code on N threads\n"
                   << "  --O0              No optimization\n"
                   << "  --O1              Basic optimizations\n"
                   << "  --O2              Standard (default)\n"
                   << "  --O3              Aggressive\n"
                   << "  --show-ir-diff    IR before/after optimization diff\n"
                   << "  --no-autocorrect  Disable auto error correction\n"
+                  << "  --release         Lean batch build: no dumps, symbol log,\n"
+                  << "                    comments or IR value names\n"
+                  << "  --check           Report errors only; no IR is generated\n"
+                  << "                    (with --test-all, for every test file)\n"
+                  << "  --int-semantics=wrap|nsw|trap\n"
+                  << "                    Signed int overflow: wraps (default),\n"
+                  << "                    is undefined, or traps\n"
+                  << "  --div=safe|unchecked|trap\n"
+                  << "                    Int division by zero: x/0 == x (default),\n"
+                  << "                    undefined, or traps\n"
+                  << "  --fast-math       All fast-math flags on float ops\n"
+                  << "                    (per function: 'fast float f() { ... }')\n"
+                  << "  --fp-contract=off|on|fast\n"
+                  << "                    Fuse a*b+c into FMA: never (default), within\n"
+                  << "                    an expression, or anywhere\n"
+                  << "  --target-cpu=<cpu>\n"
+                  << "                    Optimize for an LLVM CPU (e.g. skylake)\n"
+                  << "  --target-features=<+f,-g>\n"
+                  << "                    Enable/disable CPU features (e.g. +avx2)\n"
+                  << "  -march=native     Host CPU and all of its features\n"
                   << "  --testdir <dir>   Test directory (default: test/)\n"
                   << "  --out <dir>       Output directory (default: out/)\n\n"
                   << "OOP language features:\n"
@@ -831,8 +1258,8 @@ int main(int argc, char* argv[]) {
               << "╚══════════════════════════════════════════════════════╝\n"
               << RESET << "\n";
 
-    CompileResult r = compileOne(inputFile, outDir, debugMode, buildBin, true,
-                                 optLevel, autoCorrect, showIrDiff);
+    CompileResult r = compileOne(inputFile, outDir, debugMode, emit, buildBin, jit.get(), true,
+                                 optLevel, autoCorrect, showIrDiff, parseThreads, cgOpts);
 
     if (r.errorCount > 0 || !r.parseOk || !r.irOk) return 1;
     std::cout << "\n" << GREEN << BOLD << "Compilation successful.\n" << RESET;
@@ -0,0 +1,27 @@
+#include "parser/ASTArena.h"
+
+// Current block exhausted.  Oversized requests (a huge argument or
+// statement list) get a block of their own so the current one keeps
+// serving small nodes.
+void* ASTArena::allocateSlow(size_t size, size_t align) {
+    size_t need = size + align - 1;
+    if (need > kBlockSize / 4) {
+        blocks.emplace_back(new char[need]);
+        reserved += need;
+        uintptr_t p = ((uintptr_t)blocks.back().get() + (align - 1)) & ~(uintptr_t)(align - 1);
+        return (void*)p;
+    }
+    blocks.emplace_back(new char[kBlockSize]);
+    reserved += kBlockSize;
+    cur = blocks.back().get();
+    end = cur + kBlockSize;
+    return allocate(size, align);
+}
+
+void ASTArena::adopt(ASTArena& other) {
+    for (auto& b : other.blocks) blocks.push_back(std::move(b));
+    reserved += other.reserved;
+    other.blocks.clear();
+    other.cur = other.end = nullptr;
+    other.reserved = 0;
+}
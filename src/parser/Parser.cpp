@@ -1,8 +1,29 @@
 #include "parser/Parser.h"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <sstream>
+#include <charconv>
+#include <thread>
 
-Parser::Parser(const std::vector<Token>& t) : tokens(t), pos(0) {}
+Parser::Parser(const TokenStream& t, unsigned threads) : tokens(t), threads(threads) {}
+
+// ── Token cursor ───────────────────────────────────────────────
+// peek/check (header) read the stream's arrays directly: they look at most
+// TokenStream::kPadding - 1 tokens ahead and the cursor never moves past
+// EOF, so the EOF sentinel padding makes bounds checks unnecessary.
+
+Token Parser::advance() {
+    Token t = tokens.at(pos);
+    pos += (t.type != TokenType::EOF_TOK);
+    return t;
+}
+
+bool Parser::match(TokenType t) {
+    if (!check(t)) return false;
+    advance();
+    return true;
+}
 
 // ── Helpers ────────────────────────────────────────────────────
 
@@ -14,13 +35,19 @@ bool Parser::isTypeKeyword(TokenType t) const {
     return t == TokenType::INT || t == TokenType::FLOAT || t == TokenType::VOID;
 }
 
-int Parser::currentLine() const {
-    if (pos < tokens.size()) return tokens[pos].line;
-    return tokens.empty() ? 0 : tokens.back().line;
+// 'fast' is contextual: an identifier everywhere except directly before
+// a function's return type, so existing programs may keep using the name.
+bool Parser::isFastModifier(size_t k) const {
+    return check(TokenType::IDENT, k) && tokens.atom(pos + k) == Atom::wellKnown(Atom::Fast) &&
+           isTypeKeyword(peekType(k + 1)) && check(TokenType::IDENT, k + 2) &&
+           check(TokenType::LPAREN, k + 3);
 }
 
-void Parser::addError(const std::string& msg) {
-    int ln = currentLine();
+int Parser::currentLine() const { return tokens.line(pos); }
+
+void Parser::addError(const std::string& msg) { addError(currentLine(), msg); }
+
+void Parser::addError(int ln, const std::string& msg) {
     for (auto& e : errors)
         if (e.line == ln && e.message == msg) return;
     errors.push_back({ln, msg});
@@ -32,43 +59,81 @@ static ASTType tokenToASTType(TokenType t) {
     return ASTType::Int;
 }
 
-std::vector<std::unique_ptr<AST>> Parser::drainComments() {
-    std::vector<std::unique_ptr<AST>> out;
-    while (pos < tokens.size() && isComment(tokens[pos].type)) {
-        const Token& tok = tokens[pos++];
-        if (tok.type == TokenType::LINE_COMMENT)
-            out.push_back(std::make_unique<LineCommentAST>(tok.lexeme));
-        else
-            out.push_back(std::make_unique<BlockCommentAST>(tok.lexeme));
-    }
-    return out;
+// Token lexemes are views into the source, so convert without building a
+// temporary std::string.  False if the literal does not fit (v is then 0).
+static bool lexemeToInt(std::string_view s, int& v) {
+    v = 0;
+    return std::from_chars(s.data(), s.data() + s.size(), v).ec != std::errc::result_out_of_range;
+}
+
+static bool lexemeToDouble(std::string_view s, double& v) {
+    v = 0.0;
+    return std::from_chars(s.data(), s.data() + s.size(), v).ec != std::errc::result_out_of_range;
+}
+
+// ── Arena lists ────────────────────────────────────────────────
+
+ArenaList<AST*> Parser::takePending(size_t mark) {
+    auto list = arena->list(pending.data() + mark, pending.size() - mark);
+    pending.resize(mark);
+    return list;
+}
+
+// Comment text is copied into the arena so the tree does not depend on
+// the source buffer staying alive.
+AST* Parser::comment(const Token& tok) {
+    if (tok.type == TokenType::LINE_COMMENT)
+        return make<LineCommentAST>(arena->copy(tok.lexeme));
+    return make<BlockCommentAST>(arena->copy(tok.lexeme));
+}
+
+void Parser::drainComments() {
+    while (isComment(peekType()))
+        pending.push_back(comment(advance()));
 }
 
 void Parser::syncStatement() {
-    while (pos < tokens.size()) {
-        TokenType t = tokens[pos].type;
-        if (t == TokenType::SEMI)    { pos++; return; }
+    for (;;) {
+        TokenType t = peekType();
+        if (t == TokenType::SEMI)    { advance(); return; }
         if (t == TokenType::RBRACE)  return;
         if (t == TokenType::EOF_TOK) return;
-        pos++;
+        advance();
     }
 }
 
 void Parser::syncFunction() {
-    while (pos + 2 < tokens.size()) {
-        if (isTypeKeyword(tokens[pos].type) &&
-            tokens[pos+1].type == TokenType::IDENT &&
-            tokens[pos+2].type == TokenType::LPAREN)
+    while (!check(TokenType::EOF_TOK, 1)) {
+        if (isTypeKeyword(peekType()) &&
+            check(TokenType::IDENT, 1) &&
+            check(TokenType::LPAREN, 2))
             return;
-        if (tokens[pos].type == TokenType::CLASS) return;
-        if (tokens[pos].type == TokenType::EOF_TOK) return;
-        pos++;
+        if (check(TokenType::CLASS)) return;
+        advance();
     }
-    while (pos < tokens.size() && tokens[pos].type != TokenType::EOF_TOK) pos++;
+    while (!check(TokenType::EOF_TOK)) advance();
 }
 
 // ── Operator precedence ────────────────────────────────────────
 
+// Only called for tokens getPrecedence() accepts.
+static BinOp binOp(TokenType type) {
+    switch (type) {
+        case TokenType::PLUS:  return BinOp::Add;
+        case TokenType::MINUS: return BinOp::Sub;
+        case TokenType::MUL:   return BinOp::Mul;
+        case TokenType::DIV:   return BinOp::Div;
+        case TokenType::LT:    return BinOp::Lt;
+        case TokenType::GT:    return BinOp::Gt;
+        case TokenType::LE:    return BinOp::Le;
+        case TokenType::GE:    return BinOp::Ge;
+        case TokenType::EQ:    return BinOp::Eq;
+        case TokenType::NEQ:   return BinOp::Ne;
+        case TokenType::AND:   return BinOp::And;
+        default:               return BinOp::Or;
+    }
+}
+
 int Parser::getPrecedence(TokenType type) {
     switch (type) {
         case TokenType::MUL:
@@ -88,592 +153,618 @@ int Parser::getPrecedence(TokenType type) {
 }
 
 // ── Argument list parser (LPAREN already consumed) ─────────────
-std::vector<std::unique_ptr<AST>> Parser::parseArgList() {
-    std::vector<std::unique_ptr<AST>> args;
-    while (pos < tokens.size()
-           && tokens[pos].type != TokenType::RPAREN
-           && tokens[pos].type != TokenType::EOF_TOK) {
-        while (pos < tokens.size() && isComment(tokens[pos].type)) pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) break;
+ArenaList<AST*> Parser::parseArgList() {
+    size_t mark = pending.size();
+    while (!check(TokenType::RPAREN) && !check(TokenType::EOF_TOK)) {
+        while (isComment(peekType())) advance();
+        if (check(TokenType::RPAREN)) break;
         auto arg = expression();
-        if (arg) args.push_back(std::move(arg));
-        if (pos < tokens.size() && tokens[pos].type == TokenType::COMMA) pos++;
+        if (arg) pending.push_back(arg);
+        match(TokenType::COMMA);
     }
-    return args;
+    return takePending(mark);
 }
 
-// ── Primary ────────────────────────────────────────────────────
+// ── Operand ────────────────────────────────────────────────────
+// Everything primary except '(' and the unary operators, which the
+// expression parser handles itself.
 
-std::unique_ptr<AST> Parser::primary() {
-    if (pos >= tokens.size()) return nullptr;
+AST* Parser::operand() {
+    while (isComment(peekType())) advance();
 
-    while (pos < tokens.size() && isComment(tokens[pos].type)) pos++;
-    if (pos >= tokens.size()) return nullptr;
-
-    const Token& tok = tokens[pos];
+    Token tok = peek();
 
     // ── this.field  /  this.method(args) ──────────────────────
     if (tok.type == TokenType::THIS) {
-        pos++;
-        if (pos >= tokens.size() || tokens[pos].type != TokenType::DOT) {
+        advance();
+        if (!check(TokenType::DOT)) {
             addError("Expected '.' after 'this'");
             return nullptr;
         }
-        pos++; // consume DOT
-        if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+        advance(); // consume DOT
+        if (!check(TokenType::IDENT)) {
             addError("Expected member name after 'this.'");
             return nullptr;
         }
-        std::string member = tokens[pos++].lexeme;
+        Atom member = advance().atom;
         // this.method(args)?
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
-            pos++;
+        if (match(TokenType::LPAREN)) {
             auto args = parseArgList();
-            if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-            else addError("Missing ')' in this." + member + "()");
-            return std::make_unique<MethodCallAST>("this", member, std::move(args));
+            if (!match(TokenType::RPAREN)) addError("Missing ')' in this." + member + "()");
+            return make<MethodCallAST>(thisAtom(), member, args);
         }
-        return std::make_unique<ThisAccessAST>(member);
+        return make<ThisAccessAST>(member);
     }
 
     if (tok.type == TokenType::ASSIGN) {
-        addError("Unexpected '=' in expression"); pos++; return nullptr;
+        addError("Unexpected '=' in expression"); advance(); return nullptr;
     }
 
     if (tok.type == TokenType::NUMBER) {
-        int val = std::stoi(tok.lexeme); pos++;
-        return std::make_unique<NumberAST>(val);
+        int val;
+        if (!lexemeToInt(tok.lexeme, val))
+            addError(tok.line, "Integer literal out of range: " + std::string(tok.lexeme));
+        advance();
+        return make<NumberAST>(val);
     }
 
     if (tok.type == TokenType::FLOAT_VAL) {
-        double val = std::stod(tok.lexeme); pos++;
-        return std::make_unique<FloatAST>(val);
+        double val;
+        if (!lexemeToDouble(tok.lexeme, val))
+            addError(tok.line, "Float literal out of range: " + std::string(tok.lexeme));
+        advance();
+        return make<FloatAST>(val);
     }
 
     if (tok.type == TokenType::IDENT) {
-        std::string name = tok.lexeme; pos++;
+        Atom name = tok.atom; advance();
 
         // Post-increment  x++
-        if (pos < tokens.size() && tokens[pos].type == TokenType::INC) {
-            pos++; return std::make_unique<PostIncAST>(name);
-        }
+        if (match(TokenType::INC))
+            return make<PostIncAST>(name);
 
         // Member access / method call  obj.field  obj.method(args)
-        if (pos < tokens.size() && tokens[pos].type == TokenType::DOT) {
-            pos++; // consume DOT
-            if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+        if (match(TokenType::DOT)) {
+            if (!check(TokenType::IDENT)) {
                 addError("Expected member name after '.' on '" + name + "'");
                 return nullptr;
             }
-            std::string member = tokens[pos++].lexeme;
-            if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
-                pos++;
+            Atom member = advance().atom;
+            if (match(TokenType::LPAREN)) {
                 auto args = parseArgList();
-                if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-                else addError("Missing ')' in " + name + "." + member + "()");
-                return std::make_unique<MethodCallAST>(name, member, std::move(args));
+                if (!match(TokenType::RPAREN)) addError("Missing ')' in " + name + "." + member + "()");
+                return make<MethodCallAST>(name, member, args);
             }
-            return std::make_unique<MemberAccessAST>(name, member);
+            return make<MemberAccessAST>(name, member);
         }
 
         // Function call  name(args)
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
-            pos++;
+        if (match(TokenType::LPAREN)) {
             auto args = parseArgList();
-            if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-            else addError("Missing ')' in call to '" + name + "'");
-            auto call = std::make_unique<CallAST>();
-            call->callee = name; call->args = std::move(args);
+            if (!match(TokenType::RPAREN)) addError("Missing ')' in call to '" + name + "'");
+            auto call = make<CallAST>();
+            call->callee = name; call->args = args;
             return call;
         }
 
         // Array access  name[idx]
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LBRACKET) {
-            pos++;
+        if (match(TokenType::LBRACKET)) {
             auto idx = expression();
             if (!idx) { addError("Invalid index for '" + name + "'"); syncStatement(); return nullptr; }
-            if (pos < tokens.size() && tokens[pos].type == TokenType::RBRACKET) pos++;
-            else addError("Missing ']' in array access '" + name + "[...]'");
-            return std::make_unique<ArrayAccessAST>(name, std::move(idx));
+            if (!match(TokenType::RBRACKET)) addError("Missing ']' in array access '" + name + "[...]'");
+            return make<ArrayAccessAST>(name, idx);
         }
 
-        return std::make_unique<VariableAST>(name);
-    }
-
-    if (tok.type == TokenType::LPAREN) {
-        pos++;
-        auto expr = expression();
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-        else addError("Missing ')' in parenthesised expression");
-        return expr;
-    }
-
-    if (tok.type == TokenType::MINUS || tok.type == TokenType::NOT) {
-        std::string op = (tok.type == TokenType::MINUS) ? "-" : "!";
-        pos++;
-        auto operand = primary();
-        if (!operand) { addError("Expected expression after unary '" + op + "'"); return nullptr; }
-        auto u = std::make_unique<UnaryAST>();
-        u->op = op; u->operand = std::move(operand);
-        return u;
+        return make<VariableAST>(name);
     }
 
-    addError("Unexpected token '" + tok.lexeme + "' in expression");
-    pos++;
+    addError("Unexpected token '" + std::string(tok.lexeme) + "' in expression");
+    advance();
     return nullptr;
 }
 
-// ── Pratt expression parser ────────────────────────────────────
+// ── Expression parser ──────────────────────────────────────────
+//
+// Precedence climbing over an explicit frame stack instead of the call
+// stack:
+//
+//   expr(min) := primary { op expr(prec(op) + 1) }    while prec(op) >= min
+//   primary   := '(' expr(0) ')' | ('-' | '!') primary | operand
+//
+// '(' and the unary operators push a frame, each binary operator pushes
+// one frame for its right operand, and a finished value is handed down
+// the stack until some frame wants another operand.  Frames in flight
+// are bounded by the precedence levels and open parentheses, never by
+// expression length, and each token is looked at once.  Trees, errors
+// and error recovery are those of the recursive form above.
+
+AST* Parser::expression() {
+    // Call arguments and array indices still nest through here.
+    if (exprNesting >= kMaxExprNesting) {
+        addError("Expression nested too deeply");
+        skipNestedExpression();
+        return nullptr;
+    }
+    ++exprNesting;
 
-std::unique_ptr<AST> Parser::parseExpression(int minPrec) {
-    auto lhs = primary();
-    if (!lhs) return nullptr;
+    const size_t base = exprFrames.size();
+    exprFrames.push_back(ExprFrame::expr(0));
+    AST* value = nullptr;
 
-    while (pos < tokens.size()) {
-        while (pos < tokens.size() && isComment(tokens[pos].type)) pos++;
-        if (pos >= tokens.size()) break;
+    for (;;) {
+        // ── prefix: open frames up to the next operand ─────────
+        while (isComment(peekType())) advance();
+        TokenType t = peekType();
+        if (t == TokenType::LPAREN) {
+            advance();
+            exprFrames.push_back(ExprFrame::paren());
+            exprFrames.push_back(ExprFrame::expr(0));
+            continue;
+        }
+        if (t == TokenType::MINUS || t == TokenType::NOT) {
+            advance();
+            exprFrames.push_back(ExprFrame::unary(t == TokenType::MINUS ? UnOp::Neg : UnOp::Not));
+            continue;
+        }
+        value = operand();
+
+        // ── reduce: hand 'value' down until a frame wants an operand
+        for (;;) {
+            ExprFrame& f = exprFrames.back();
+
+            if (f.kind == ExprFrame::Unary) {
+                if (value) {
+                    auto u = make<UnaryAST>();
+                    u->op = f.unOp; u->operand = value;
+                    value = u;
+                } else {
+                    addError(std::string("Expected expression after unary '") + opSpelling(f.unOp) + "'");
+                }
+                exprFrames.pop_back();
+                continue;
+            }
+            if (f.kind == ExprFrame::Paren) {
+                if (!match(TokenType::RPAREN)) addError("Missing ')' in parenthesised expression");
+                exprFrames.pop_back();
+                continue;
+            }
 
-        TokenType opType = tokens[pos].type;
-        int prec = getPrecedence(opType);
-        if (prec < minPrec) break;
+            bool done = false;
+            if (!f.lhs) {                       // first operand
+                if (value) f.lhs = value;
+                else done = true;               // expr() fails with it
+            } else if (!value) {                // right operand of f.op failed
+                addError(std::string("Expected right-hand side after '") + opSpelling(f.op) + "'");
+                value = f.lhs;
+                done  = true;
+            } else if (f.op == BinOp::And || f.op == BinOp::Or ||
+                       f.op == BinOp::Eq  || f.op == BinOp::Ne) {
+                auto log = make<LogicalAST>();
+                log->op = f.op; log->lhs = f.lhs; log->rhs = value;
+                f.lhs = log;
+            } else {
+                auto bin = make<BinaryAST>();
+                bin->op = f.op; bin->lhs = f.lhs; bin->rhs = value;
+                f.lhs = bin;
+            }
 
-        std::string opStr = tokens[pos++].lexeme;
-        auto rhs = parseExpression(prec + 1);
-        if (!rhs) { addError("Expected right-hand side after '" + opStr + "'"); break; }
+            if (!done) {
+                while (isComment(peekType())) advance();
+                TokenType opType = peekType();
+                int prec = getPrecedence(opType);
+                if (prec >= f.minPrec) {
+                    advance();
+                    f.op = binOp(opType);
+                    exprFrames.push_back(ExprFrame::expr(prec + 1));   // invalidates f
+                    break;
+                }
+                value = f.lhs;
+            }
 
-        if (opType == TokenType::AND || opType == TokenType::OR ||
-            opType == TokenType::EQ  || opType == TokenType::NEQ) {
-            auto log = std::make_unique<LogicalAST>();
-            log->op = opStr; log->lhs = std::move(lhs); log->rhs = std::move(rhs);
-            lhs = std::move(log);
-        } else {
-            auto bin = std::make_unique<BinaryAST>();
-            bin->op = opStr; bin->lhs = std::move(lhs); bin->rhs = std::move(rhs);
-            lhs = std::move(bin);
+            exprFrames.pop_back();
+            if (exprFrames.size() == base) {
+                --exprNesting;
+                return value;
+            }
         }
     }
-    return lhs;
 }
 
-std::unique_ptr<AST> Parser::expression() { return parseExpression(0); }
+// Recovery for an over-deep nest: drop the rest of it, up to the
+// bracket or statement end that closes it.  Always consumes a token so
+// argument-list loops make progress.
+void Parser::skipNestedExpression() {
+    int depth = 0;
+    if (!check(TokenType::EOF_TOK)) {
+        TokenType t = advance().type;
+        if (t == TokenType::LPAREN || t == TokenType::LBRACKET) ++depth;
+    }
+    for (;;) {
+        TokenType t = peekType();
+        if (t == TokenType::EOF_TOK) return;
+        if (depth == 0 && (t == TokenType::RPAREN || t == TokenType::RBRACKET ||
+                           t == TokenType::COMMA  || t == TokenType::SEMI ||
+                           t == TokenType::RBRACE))
+            return;
+        if (t == TokenType::LPAREN || t == TokenType::LBRACKET) ++depth;
+        if (t == TokenType::RPAREN || t == TokenType::RBRACKET) --depth;
+        advance();
+    }
+}
 
 // ── Block ──────────────────────────────────────────────────────
 
-std::unique_ptr<BlockAST> Parser::block() {
-    if (pos < tokens.size() && tokens[pos].type == TokenType::LBRACE) pos++;
-    else addError("Expected '{' to open block");
+BlockAST* Parser::block() {
+    if (!match(TokenType::LBRACE)) addError("Expected '{' to open block");
 
-    auto b = std::make_unique<BlockAST>();
+    auto b = make<BlockAST>();
+    size_t mark = pending.size();
 
-    while (pos < tokens.size()
-           && tokens[pos].type != TokenType::RBRACE
-           && tokens[pos].type != TokenType::EOF_TOK)
+    while (!check(TokenType::RBRACE) && !check(TokenType::EOF_TOK))
     {
-        for (auto& c : drainComments())
-            b->statements.push_back(std::move(c));
+        drainComments();
 
-        if (pos >= tokens.size()
-            || tokens[pos].type == TokenType::RBRACE
-            || tokens[pos].type == TokenType::EOF_TOK) break;
+        if (check(TokenType::RBRACE) || check(TokenType::EOF_TOK)) break;
 
         auto stmt = statement();
-        if (stmt) b->statements.push_back(std::move(stmt));
+        if (stmt) pending.push_back(stmt);
         else      syncStatement();
     }
 
-    if (pos < tokens.size() && tokens[pos].type == TokenType::RBRACE) pos++;
-    else addError("Missing '}' at end of block");
+    if (!match(TokenType::RBRACE)) addError("Missing '}' at end of block");
 
+    b->statements = takePending(mark);
     return b;
 }
 
 // ── Statement ──────────────────────────────────────────────────
 
-std::unique_ptr<AST> Parser::statement() {
-    if (pos >= tokens.size()) return nullptr;
+AST* Parser::statement() {
+    if (isComment(peekType()))
+        return comment(advance());
 
-    if (isComment(tokens[pos].type)) {
-        const Token& t = tokens[pos++];
-        if (t.type == TokenType::LINE_COMMENT)
-            return std::make_unique<LineCommentAST>(t.lexeme);
-        return std::make_unique<BlockCommentAST>(t.lexeme);
-    }
-
-    const Token& tok = tokens[pos];
+    Token tok = peek();
 
     if (tok.type == TokenType::LBRACE)
         return block();
 
     // ── this.field = expr;  (inside method) ───────────────────
     if (tok.type == TokenType::THIS
-        && pos+1 < tokens.size() && tokens[pos+1].type == TokenType::DOT)
+        && check(TokenType::DOT, 1)
+        && check(TokenType::IDENT, 2)
+        && check(TokenType::ASSIGN, 3))
     {
-        size_t savedPos = pos;
-        pos += 2; // skip this + .
-        if (pos < tokens.size() && tokens[pos].type == TokenType::IDENT) {
-            std::string field = tokens[pos++].lexeme;
-            if (pos < tokens.size() && tokens[pos].type == TokenType::ASSIGN) {
-                pos++;
-                auto val = expression();
-                if (!val) { addError("Invalid rhs in 'this." + field + " = ...'"); syncStatement(); return nullptr; }
-                if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-                else addError("Missing ';' after this." + field + " assignment");
-                return std::make_unique<ThisAssignAST>(field, std::move(val));
-            }
-        }
-        // Not an assignment — fall through to expression statement
-        pos = savedPos;
+        advance(); advance(); // skip this + .
+        Atom field = advance().atom;
+        advance(); // =
+        auto val = expression();
+        if (!val) { addError("Invalid rhs in 'this." + field + " = ...'"); syncStatement(); return nullptr; }
+        if (!match(TokenType::SEMI)) addError("Missing ';' after this." + field + " assignment");
+        return make<ThisAssignAST>(field, val);
     }
+    // Otherwise 'this.' starts an expression statement (handled below).
 
     // ── obj.field = expr;  (member assignment) ────────────────
     if (tok.type == TokenType::IDENT
-        && pos+1 < tokens.size() && tokens[pos+1].type == TokenType::DOT)
+        && check(TokenType::DOT, 1)
+        && check(TokenType::IDENT, 2)
+        && check(TokenType::ASSIGN, 3))
     {
-        // Look ahead: IDENT DOT IDENT ASSIGN
-        size_t savedPos = pos;
-        std::string objName = tokens[pos].lexeme; pos += 2; // skip obj + .
-        if (pos < tokens.size() && tokens[pos].type == TokenType::IDENT) {
-            std::string member = tokens[pos++].lexeme;
-            if (pos < tokens.size() && tokens[pos].type == TokenType::ASSIGN) {
-                pos++;
-                auto val = expression();
-                if (!val) { addError("Invalid rhs in '" + objName + "." + member + " = ...'"); syncStatement(); return nullptr; }
-                if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-                else addError("Missing ';' after " + objName + "." + member + " assignment");
-                return std::make_unique<MemberAssignAST>(objName, member, std::move(val));
-            }
-        }
-        // Not a member assignment — restore and fall through
-        pos = savedPos;
+        Atom objName = advance().atom; advance(); // skip obj + .
+        Atom member = advance().atom;
+        advance(); // =
+        auto val = expression();
+        if (!val) { addError("Invalid rhs in '" + objName + "." + member + " = ...'"); syncStatement(); return nullptr; }
+        if (!match(TokenType::SEMI)) addError("Missing ';' after " + objName + "." + member + " assignment");
+        return make<MemberAssignAST>(objName, member, val);
     }
 
     // ── Object declaration  ClassName varName; ────────────────
     if (tok.type == TokenType::IDENT
-        && classNames.count(tok.lexeme)
-        && pos+1 < tokens.size() && tokens[pos+1].type == TokenType::IDENT)
+        && classNames.count(tok.atom)
+        && check(TokenType::IDENT, 1))
     {
-        std::string className = tokens[pos].lexeme;
-        std::string varName   = tokens[pos+1].lexeme;
-        pos += 2;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after object declaration '" + className + " " + varName + "'");
-        return std::make_unique<ObjectDeclAST>(className, varName);
+        Atom className = advance().atom;
+        Atom varName = advance().atom;
+        if (!match(TokenType::SEMI))
+            addError("Missing ';' after object declaration '" + className + " " + varName + "'");
+        return make<ObjectDeclAST>(className, varName);
     }
 
     // ── Array assignment  name[idx] = expr; ───────────────────
-    if (tok.type == TokenType::IDENT
-        && pos+1 < tokens.size()
-        && tokens[pos+1].type == TokenType::LBRACKET)
+    if (tok.type == TokenType::IDENT && check(TokenType::LBRACKET, 1))
     {
-        std::string name = tokens[pos].lexeme; pos++; pos++;
+        Atom name = advance().atom; advance();
         auto idx = expression();
         if (!idx) { addError("Invalid index in assignment to '" + name + "[...]'"); syncStatement(); return nullptr; }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RBRACKET) pos++;
-        else addError("Missing ']' in array assignment to '" + name + "'");
-        if (pos >= tokens.size() || tokens[pos].type != TokenType::ASSIGN) {
+        if (!match(TokenType::RBRACKET)) addError("Missing ']' in array assignment to '" + name + "'");
+        if (!check(TokenType::ASSIGN)) {
             addError("Expected '=' after '" + name + "[...]'"); syncStatement(); return nullptr; }
-        pos++;
+        advance();
         auto val = expression();
         if (!val) { addError("Invalid value in assignment to '" + name + "[...]'"); syncStatement(); return nullptr; }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after array assignment to '" + name + "[...]'");
-        return std::make_unique<ArrayAssignAST>(name, std::move(idx), std::move(val));
+        if (!match(TokenType::SEMI)) addError("Missing ';' after array assignment to '" + name + "[...]'");
+        return make<ArrayAssignAST>(name, idx, val);
     }
 
     // ── Simple assignment  name = expr; ───────────────────────
-    if (tok.type == TokenType::IDENT
-        && pos+1 < tokens.size()
-        && tokens[pos+1].type == TokenType::ASSIGN)
+    if (tok.type == TokenType::IDENT && check(TokenType::ASSIGN, 1))
     {
-        std::string name = tokens[pos].lexeme; pos += 2;
+        Atom name = advance().atom; advance();
         auto val = expression();
         if (!val) { addError("Invalid expression in assignment to '" + name + "'"); syncStatement(); return nullptr; }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after assignment to '" + name + "'");
-        return std::make_unique<AssignAST>(name, std::move(val));
+        if (!match(TokenType::SEMI)) addError("Missing ';' after assignment to '" + name + "'");
+        return make<AssignAST>(name, val);
     }
 
     // ── Variable / array declaration ──────────────────────────
     if (isTypeKeyword(tok.type)) {
         ASTType declType = tokenToASTType(tok.type);
-        pos++;
-        if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+        advance();
+        if (!check(TokenType::IDENT)) {
             addError("Expected variable name after type keyword"); syncStatement(); return nullptr; }
-        std::string name = tokens[pos++].lexeme;
+        Atom name = advance().atom;
 
         // Array declaration  type name[size];
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LBRACKET) {
-            pos++;
-            if (pos >= tokens.size() || tokens[pos].type != TokenType::NUMBER) {
+        if (match(TokenType::LBRACKET)) {
+            if (!check(TokenType::NUMBER)) {
                 addError("Expected size in array declaration '" + name + "[...]'"); syncStatement(); return nullptr; }
-            int size = std::stoi(tokens[pos++].lexeme);
+            Token sizeTok = advance();
+            int size;
+            if (!lexemeToInt(sizeTok.lexeme, size)) {
+                addError(sizeTok.line, "Integer literal out of range: " + std::string(sizeTok.lexeme));
+                syncStatement(); return nullptr;
+            }
             if (size <= 0) { addError("Array size must be positive"); syncStatement(); return nullptr; }
-            if (pos < tokens.size() && tokens[pos].type == TokenType::RBRACKET) pos++;
-            else addError("Missing ']' in array declaration '" + name + "[...]'");
-            if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-            else addError("Missing ';' after array declaration '" + name + "[...]'");
-            return std::make_unique<ArrayDeclAST>(name, size, declType);
+            if (!match(TokenType::RBRACKET)) addError("Missing ']' in array declaration '" + name + "[...]'");
+            if (!match(TokenType::SEMI)) addError("Missing ';' after array declaration '" + name + "[...]'");
+            return make<ArrayDeclAST>(name, size, declType);
         }
 
         // Declaration with initialiser  type name = expr;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::ASSIGN) {
-            pos++;
+        if (match(TokenType::ASSIGN)) {
             auto initExpr = expression();
             if (!initExpr) { addError("Expected initializer for '" + name + "'"); syncStatement(); return nullptr; }
-            if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-            else addError("Missing ';' after declaration of '" + name + "'");
+            if (!match(TokenType::SEMI)) addError("Missing ';' after declaration of '" + name + "'");
             // Use VarDeclInitAST so the variable stays in the CURRENT scope,
             // not a child scope (the old BlockAST wrapper caused "undeclared variable" errors).
-            return std::make_unique<VarDeclInitAST>(name, declType, std::move(initExpr));
+            return make<VarDeclInitAST>(name, declType, initExpr);
         }
 
         // Plain declaration  type name;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) {
-            pos++;
-            return std::make_unique<VarDeclAST>(name, declType);
-        }
+        if (match(TokenType::SEMI))
+            return make<VarDeclAST>(name, declType);
         addError("Missing ';' after variable declaration '" + name + "'");
         syncStatement(); return nullptr;
     }
 
     // ── return ─────────────────────────────────────────────────
     if (tok.type == TokenType::RETURN) {
-        pos++;
-        while (pos < tokens.size() && isComment(tokens[pos].type)) pos++;
-        std::unique_ptr<AST> expr;
-        if (pos < tokens.size() && tokens[pos].type != TokenType::SEMI)
+        advance();
+        while (isComment(peekType())) advance();
+        AST* expr = nullptr;
+        if (!check(TokenType::SEMI))
             expr = expression();
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after return statement");
-        return std::make_unique<ReturnAST>(std::move(expr));
+        if (!match(TokenType::SEMI)) addError("Missing ';' after return statement");
+        return make<ReturnAST>(expr);
     }
 
     // ── if / if-else ───────────────────────────────────────────
     if (tok.type == TokenType::IF) {
-        pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) pos++;
-        else addError("Expected '(' after 'if'");
+        advance();
+        if (!match(TokenType::LPAREN)) addError("Expected '(' after 'if'");
         auto cond = expression();
         if (!cond) { addError("Invalid 'if' condition"); syncStatement(); return nullptr; }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-        else addError("Missing ')' after 'if' condition");
+        if (!match(TokenType::RPAREN)) addError("Missing ')' after 'if' condition");
         auto thenB = block();
-        std::unique_ptr<AST> elseB;
-        while (pos < tokens.size() && isComment(tokens[pos].type)) pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::ELSE) { pos++; elseB = block(); }
-        auto node = std::make_unique<IfAST>();
-        node->cond = std::move(cond); node->thenBlock = std::move(thenB); node->elseBlock = std::move(elseB);
+        AST* elseB = nullptr;
+        while (isComment(peekType())) advance();
+        if (match(TokenType::ELSE)) elseB = block();
+        auto node = make<IfAST>();
+        node->cond = cond; node->thenBlock = thenB; node->elseBlock = elseB;
         return node;
     }
 
     // ── while ──────────────────────────────────────────────────
     if (tok.type == TokenType::WHILE) {
-        pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) pos++;
-        else addError("Expected '(' after 'while'");
+        advance();
+        if (!match(TokenType::LPAREN)) addError("Expected '(' after 'while'");
         auto cond = expression();
         if (!cond) { addError("Invalid 'while' condition"); syncStatement(); return nullptr; }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-        else addError("Missing ')' after 'while' condition");
+        if (!match(TokenType::RPAREN)) addError("Missing ')' after 'while' condition");
         auto body = block();
-        auto node = std::make_unique<WhileAST>();
-        node->cond = std::move(cond); node->body = std::move(body);
+        auto node = make<WhileAST>();
+        node->cond = cond; node->body = body;
         return node;
     }
 
     // ── for ────────────────────────────────────────────────────
     if (tok.type == TokenType::FOR) {
-        pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) pos++;
-        else addError("Expected '(' after 'for'");
-        std::unique_ptr<AST> init;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::IDENT
-            && pos+1 < tokens.size() && tokens[pos+1].type == TokenType::ASSIGN) {
-            std::string name = tokens[pos].lexeme; pos += 2;
+        advance();
+        if (!match(TokenType::LPAREN)) addError("Expected '(' after 'for'");
+        AST* init = nullptr;
+        if (check(TokenType::IDENT) && check(TokenType::ASSIGN, 1)) {
+            Atom name = advance().atom; advance();
             auto val = expression();
-            if (val) init = std::make_unique<AssignAST>(name, std::move(val));
+            if (val) init = make<AssignAST>(name, val);
             else addError("Invalid initializer in 'for' loop");
-        } else if (pos < tokens.size() && tokens[pos].type != TokenType::SEMI) {
+        } else if (!check(TokenType::SEMI)) {
             init = expression();
         }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after 'for' initializer");
+        if (!match(TokenType::SEMI)) addError("Missing ';' after 'for' initializer");
         auto cond = expression();
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after 'for' condition");
+        if (!match(TokenType::SEMI)) addError("Missing ';' after 'for' condition");
         auto inc = expression();
-        if (pos < tokens.size() && tokens[pos].type == TokenType::RPAREN) pos++;
-        else addError("Missing ')' after 'for' increment");
+        if (!match(TokenType::RPAREN)) addError("Missing ')' after 'for' increment");
         auto body = block();
-        return std::make_unique<ForAST>(std::move(init), std::move(cond),
-                                        std::move(inc), std::move(body));
+        return make<ForAST>(init, cond,
+                                        inc, body);
     }
 
     // ── break / continue ───────────────────────────────────────
     if (tok.type == TokenType::BREAK) {
-        pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after 'break'");
-        return std::make_unique<BreakAST>();
+        advance();
+        if (!match(TokenType::SEMI)) addError("Missing ';' after 'break'");
+        return make<BreakAST>();
     }
     if (tok.type == TokenType::CONTINUE) {
-        pos++;
-        if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-        else addError("Missing ';' after 'continue'");
-        return std::make_unique<ContinueAST>();
+        advance();
+        if (!match(TokenType::SEMI)) addError("Missing ';' after 'continue'");
+        return make<ContinueAST>();
     }
 
     // ── Expression statement (inc. method calls, post-inc) ─────
     auto expr = expression();
     if (!expr) {
-        addError("Unrecognised statement starting with '" + tok.lexeme + "'");
+        addError("Unrecognised statement starting with '" + std::string(tok.lexeme) + "'");
         syncStatement(); return nullptr;
     }
-    if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) pos++;
-    else addError("Missing ';' after expression statement");
+    if (!match(TokenType::SEMI)) addError("Missing ';' after expression statement");
     return expr;
 }
 
 // ── Function definition ────────────────────────────────────────
 
-std::unique_ptr<FunctionAST> Parser::function() {
-    if (pos >= tokens.size() || !isTypeKeyword(tokens[pos].type)) {
+FunctionAST* Parser::function() {
+    bool fast = isFastModifier();
+    if (fast) advance();
+    if (!isTypeKeyword(peekType())) {
         addError("Expected return type (int/float/void) for function");
         return nullptr;
     }
-    ASTType retType = tokenToASTType(tokens[pos].type);
-    pos++;
+    ASTType retType = tokenToASTType(advance().type);
 
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+    if (!check(TokenType::IDENT)) {
         addError("Expected function name after return type"); return nullptr; }
-    std::string name = tokens[pos++].lexeme;
+    Atom name = advance().atom;
 
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::LPAREN) {
+    if (!check(TokenType::LPAREN)) {
         addError("Expected '(' after function name '" + name + "'"); return nullptr; }
-    pos++;
+    advance();
 
-    std::vector<std::string> args;
+    std::vector<Atom>        args;
     std::vector<ASTType>     argTypes;
 
-    while (pos < tokens.size()
-           && tokens[pos].type != TokenType::RPAREN
-           && tokens[pos].type != TokenType::EOF_TOK)
+    while (!check(TokenType::RPAREN) && !check(TokenType::EOF_TOK))
     {
         ASTType paramType = ASTType::Int;
-        if (isTypeKeyword(tokens[pos].type)) {
-            paramType = tokenToASTType(tokens[pos].type);
-            pos++;
-        }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::IDENT) {
-            args.push_back(tokens[pos++].lexeme);
+        if (isTypeKeyword(peekType()))
+            paramType = tokenToASTType(advance().type);
+        if (check(TokenType::IDENT)) {
+            args.push_back(advance().atom);
             argTypes.push_back(paramType);
         } else {
             addError("Expected parameter name in '" + name + "'"); break;
         }
-        if (pos < tokens.size() && tokens[pos].type == TokenType::COMMA) pos++;
+        match(TokenType::COMMA);
     }
 
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::RPAREN)
+    if (!match(TokenType::RPAREN))
         addError("Missing ')' in parameter list of '" + name + "'");
-    else pos++;
 
-    auto proto        = std::make_unique<PrototypeAST>();
+    auto proto        = make<PrototypeAST>();
     proto->name       = name;
-    proto->args       = std::move(args);
-    proto->argTypes   = std::move(argTypes);
+    proto->args       = arena->list(args);
+    proto->argTypes   = arena->list(argTypes);
     proto->returnType = retType;
+    proto->fast       = fast;
 
     auto body = block();
-    return std::make_unique<FunctionAST>(std::move(proto), std::move(body));
+    return make<FunctionAST>(proto, body);
 }
 
 // ── Class definition ───────────────────────────────────────────
 
-std::unique_ptr<ClassDeclAST> Parser::parseClass() {
+ClassDeclAST* Parser::parseClass() {
     // consume 'class'
-    pos++;
+    advance();
 
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+    if (!check(TokenType::IDENT)) {
         addError("Expected class name after 'class'");
         return nullptr;
     }
-    std::string name = tokens[pos++].lexeme;
+    Atom name = advance().atom;
     classNames.insert(name);  // register so object-decl parsing works inside other classes
+    classOrder.push_back(name);
 
-    if (pos >= tokens.size() || tokens[pos].type != TokenType::LBRACE) {
+    if (!check(TokenType::LBRACE)) {
         addError("Expected '{' after class name '" + name + "'");
         return nullptr;
     }
-    pos++; // consume '{'
+    advance(); // consume '{'
 
-    auto cls = std::make_unique<ClassDeclAST>();
+    auto cls = make<ClassDeclAST>();
     cls->name = name;
+    std::vector<ClassField>   fields;
+    std::vector<FunctionAST*> methods;
 
-    while (pos < tokens.size()
-           && tokens[pos].type != TokenType::RBRACE
-           && tokens[pos].type != TokenType::EOF_TOK)
+    while (!check(TokenType::RBRACE) && !check(TokenType::EOF_TOK))
     {
         // Drain comments
-        if (isComment(tokens[pos].type)) { pos++; continue; }
+        if (isComment(peekType())) { advance(); continue; }
 
         // Skip access modifiers: public / private  (no enforcement)
-        if (tokens[pos].type == TokenType::PUBLIC || tokens[pos].type == TokenType::PRIVATE) {
-            pos++; continue;
+        if (check(TokenType::PUBLIC) || check(TokenType::PRIVATE)) {
+            advance(); continue;
+        }
+
+        // fast-math method
+        if (isFastModifier()) {
+            auto method = function();
+            if (method) methods.push_back(method);
+            continue;
         }
 
         // Member must start with a type keyword
-        if (!isTypeKeyword(tokens[pos].type)) {
+        if (!isTypeKeyword(peekType())) {
             addError("Expected type keyword in class '" + name + "' body");
-            pos++; continue;
+            advance(); continue;
         }
 
         // Peek: type IDENT '(' → method;  type IDENT ';' → field
-        size_t savedPos = pos;
-        ASTType declType = tokenToASTType(tokens[pos].type);
-        pos++;
-        if (pos >= tokens.size() || tokens[pos].type != TokenType::IDENT) {
+        if (check(TokenType::IDENT, 1) && check(TokenType::LPAREN, 2)) {
+            auto method = function();
+            if (method) methods.push_back(method);
+            continue;
+        }
+
+        ASTType declType = tokenToASTType(advance().type);
+        if (!check(TokenType::IDENT)) {
             addError("Expected member name in class '" + name + "'");
             syncStatement(); continue;
         }
-        std::string memberName = tokens[pos++].lexeme;
+        Atom memberName = advance().atom;
 
-        if (pos < tokens.size() && tokens[pos].type == TokenType::LPAREN) {
-            // Method — back up to type token and call function()
-            pos = savedPos;
-            auto method = function();
-            if (method) cls->methods.push_back(std::move(method));
-        } else if (pos < tokens.size() && tokens[pos].type == TokenType::SEMI) {
+        if (match(TokenType::SEMI)) {
             // Field
-            pos++;
-            cls->fields.push_back({memberName, declType});
+            fields.push_back({memberName, declType});
         } else {
             addError("Expected ';' or '(' after member '" + memberName + "' in class '" + name + "'");
             syncStatement();
         }
     }
 
-    if (pos < tokens.size() && tokens[pos].type == TokenType::RBRACE) pos++;
-    else addError("Missing '}' at end of class '" + name + "'");
+    if (!match(TokenType::RBRACE)) addError("Missing '}' at end of class '" + name + "'");
 
+    cls->fields  = arena->list(fields);
+    cls->methods = arena->list(methods);
     return cls;
 }
 
 // ── Top-level parse ────────────────────────────────────────────
 
-std::unique_ptr<AST> Parser::parse() {
-    auto program = std::make_unique<ProgramAST>();
-
-    while (pos < tokens.size() && tokens[pos].type != TokenType::EOF_TOK) {
-        auto comments = drainComments();
-        for (auto& c : comments)
-            program->topLevel.push_back(std::move(c));
+// Parses top-level items onto 'pending' until the cursor reaches 'end'
+// (or EOF).  Each iteration starts where the previous item stopped.
+void Parser::topLevel(size_t end) {
+    while (pos < end && !check(TokenType::EOF_TOK)) {
+        drainComments();
 
-        if (pos >= tokens.size() || tokens[pos].type == TokenType::EOF_TOK) break;
+        if (check(TokenType::EOF_TOK)) break;
 
         // Class definition
-        if (tokens[pos].type == TokenType::CLASS) {
+        if (check(TokenType::CLASS)) {
             auto cls = parseClass();
-            if (cls) program->topLevel.push_back(std::move(cls));
+            if (cls) pending.push_back(cls);
             else syncFunction();
             continue;
         }
@@ -682,11 +773,133 @@ std::unique_ptr<AST> Parser::parse() {
         size_t before = pos;
         auto fn = function();
         if (fn) {
-            program->topLevel.push_back(std::move(fn));
+            pending.push_back(fn);
         } else {
-            if (pos == before) pos++;
+            if (pos == before) advance();
             syncFunction();
         }
     }
+}
+
+std::unique_ptr<ProgramAST> Parser::parse() {
+    auto program = std::make_unique<ProgramAST>();
+    arena = &program->arena;
+    pending.clear();
+    exprFrames.clear();
+    exprNesting = 0;
+
+    if (threads > 1 && tokens.size() >= kMinParallelTokens)
+        pos = parseParallel(*program);
+    topLevel(tokens.size());
+
+    program->topLevel = takePending(0);
+    arena = nullptr;
     return program;
 }
+
+// ── Parallel top level ─────────────────────────────────────────
+// Top-level items only share the set of class names declared before
+// them, which decides whether 'Foo x;' declares an object.  A pre-scan
+// over token types cuts the stream after every '}' that closes depth 0
+// and predicts each cut's class names from 'class IDENT' at depth 0.
+// Runs of cuts are parsed on a small pool, each piece by its own Parser
+// into its own arena, and stitched back in source order.
+//
+// A piece is kept only if the serial parser provably does the same thing:
+// parsing it from its start with the predicted class names stopped exactly
+// at the next piece and registered exactly the predicted classes (error
+// recovery may resync elsewhere).  From the first piece that fails the
+// check, the rest of the program is parsed serially.  Errors are re-added
+// in order through addError, so de-duplication matches too.
+
+struct Parser::Piece {
+    size_t                  begin = 0, end = 0;              // token range
+    size_t                  classBegin = 0, classEnd = 0;    // predicted names
+    ASTArena                arena;
+    std::vector<AST*>       items;
+    std::vector<ParseError> errors;
+    bool                    ok = false;
+};
+
+void Parser::parsePiece(Piece& piece, const std::vector<Atom>& predicted) const {
+    Parser sub(tokens);
+    sub.arena = &piece.arena;
+    sub.pos   = piece.begin;
+    sub.classNames.insert(predicted.begin(), predicted.begin() + piece.classBegin);
+    sub.topLevel(piece.end);
+
+    piece.ok = sub.pos == piece.end &&
+               std::equal(sub.classOrder.begin(), sub.classOrder.end(),
+                          predicted.begin() + piece.classBegin,
+                          predicted.begin() + piece.classEnd);
+    piece.items  = std::move(sub.pending);
+    piece.errors = std::move(sub.errors);
+}
+
+// Returns the token position the serial parse resumes from.
+size_t Parser::parseParallel(ProgramAST& program) {
+    // ── pre-scan ───────────────────────────────────────────────
+    size_t eof = tokens.size() - 1;
+    std::vector<size_t> cuts{0};
+    std::vector<Atom>   predicted;
+    std::vector<size_t> predictedAt;   // token position of each name
+    int depth = 0;
+    for (size_t i = 0; i < eof; ++i) {
+        switch (tokens.type(i)) {
+        case TokenType::LBRACE:
+            ++depth;
+            break;
+        case TokenType::RBRACE:
+            if (depth > 0 && --depth == 0) cuts.push_back(i + 1);
+            break;
+        case TokenType::CLASS:
+            if (depth == 0 && tokens.type(i + 1) == TokenType::IDENT) {
+                predicted.push_back(tokens.atom(i + 1));
+                predictedAt.push_back(i);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    if (cuts.back() != eof) cuts.push_back(eof);
+    if (cuts.size() < 3) return 0;
+
+    // ── pieces: about four per thread, split by token count ───
+    size_t target = std::max<size_t>(eof / (threads * 4), 1);
+    std::vector<size_t> bounds{0};
+    for (size_t c : cuts)
+        if (c == eof || c - bounds.back() >= target) bounds.push_back(c);
+
+    std::vector<Piece> pieces(bounds.size() - 1);
+    for (size_t k = 0; k < pieces.size(); ++k) {
+        Piece& p = pieces[k];
+        p.begin = bounds[k];
+        p.end   = bounds[k + 1];
+        p.classBegin = std::lower_bound(predictedAt.begin(), predictedAt.end(), p.begin) - predictedAt.begin();
+        p.classEnd   = std::lower_bound(predictedAt.begin(), predictedAt.end(), p.end) - predictedAt.begin();
+    }
+
+    // ── parse ──────────────────────────────────────────────────
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t k; (k = next++) < pieces.size();) parsePiece(pieces[k], predicted);
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < std::min<size_t>(threads, pieces.size()); ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    // ── stitch ─────────────────────────────────────────────────
+    for (Piece& p : pieces) {
+        if (!p.ok) return p.begin;
+        pending.insert(pending.end(), p.items.begin(), p.items.end());
+        for (const ParseError& e : p.errors) addError(e.line, e.message);
+        for (size_t c = p.classBegin; c < p.classEnd; ++c) {
+            classNames.insert(predicted[c]);
+            classOrder.push_back(predicted[c]);
+        }
+        program.arena.adopt(p.arena);
+    }
+    return eof;
+}
@@ -0,0 +1,578 @@
+#include "semantic/Checker.h"
+
+static ValueType toValueType(ASTType t) {
+    switch (t) {
+        case ASTType::Float: return ValueType::Float;
+        case ASTType::Void:  return ValueType::Void;
+        default:             return ValueType::Int;
+    }
+}
+
+static bool isScalar(SymbolKind k) {
+    return k == SymbolKind::Variable || k == SymbolKind::Parameter;
+}
+
+void Checker::addError(const std::string& msg) {
+    for (auto& e : errors) if (e.message == msg) return;
+    errors.push_back({msg});
+}
+
+// ── Types ─────────────────────────────────────────────────────
+
+Checker::Ty Checker::typeOf(ASTType t) { return typeOf(toValueType(t)); }
+
+Checker::Ty Checker::typeOf(ValueType t) {
+    switch (t) {
+        case ValueType::Float: return Ty::Float;
+        case ValueType::Void:  return Ty::Void;
+        default:               return Ty::Int;
+    }
+}
+
+// A void slot was already reported where it was declared; reading it
+// yields nothing, so the error does not cascade.
+Checker::Ty Checker::storedAs(ValueType t) {
+    return t == ValueType::Void ? Ty::None : typeOf(t);
+}
+
+Checker::Signature Checker::signatureOf(const PrototypeAST* proto, bool method) {
+    Signature sig;
+    sig.ret = typeOf(proto->returnType);
+    if (method) sig.params.push_back(Ty::Ptr);
+    for (size_t i = 0; i < proto->args.size(); ++i)
+        sig.params.push_back(typeOf(i < proto->argTypes.size() ? proto->argTypes[i] : ASTType::Int));
+    return sig;
+}
+
+// CodeGen::coerce's conversions; a failed one reports and carries on
+// as if it had converted.
+Checker::Ty Checker::coerce(Ty val, Ty target) {
+    if (val == Ty::None || target == Ty::None || val == target) return val;
+    if ((val == Ty::Bool  && (target == Ty::Int || target == Ty::Float)) ||
+        (val == Ty::Int   && (target == Ty::Float || target == Ty::Bool)) ||
+        (val == Ty::Float && target == Ty::Int))
+        return target;
+    addError("Type mismatch: cannot coerce types");
+    return target;
+}
+
+Checker::Ty Checker::toBool(Ty val) {
+    if (val == Ty::None) return Ty::None;
+    if (val == Ty::Bool || val == Ty::Int || val == Ty::Float) return Ty::Bool;
+    addError("toBool: unsupported type");
+    return Ty::None;
+}
+
+// ── Names ─────────────────────────────────────────────────────
+
+void Checker::declare(int slot, SymbolKind kind, ValueType type, Atom objectClass) {
+    if (slot >= 0 && slot < (int)locals.size()) locals[slot] = {kind, type, objectClass};
+}
+
+// An unbound reference names a function, if one is defined by now and
+// no local hides it, or nothing.
+const Checker::Local* Checker::lookup(Atom name, int slot) const {
+    static const Local function{SymbolKind::Function, ValueType::Int, Atom()};
+    if (slot >= 0 && slot < (int)locals.size()) return &locals[slot];
+    return functions.count(name) ? &function : nullptr;
+}
+
+// ── Functions ─────────────────────────────────────────────────
+
+// Parameters hold slots 0..n-1; a repeated name is a redeclaration.
+void Checker::enterFunction(const FunctionAST* f, Atom callName) {
+    const PrototypeAST* proto = f->proto;
+    currentFunction = callName;
+    locals.assign(f->slotCount, Local{});
+    for (size_t i = 0; i < proto->args.size(); ++i) {
+        Atom    pname = proto->args[i];
+        ASTType at    = i < proto->argTypes.size() ? proto->argTypes[i] : ASTType::Int;
+        if (at == ASTType::Void) addError("Parameter '" + pname + "' cannot be void");
+        bool duplicate = false;
+        for (size_t j = 0; j < i; ++j) duplicate |= proto->args[j] == pname;
+        if (duplicate) addError("Redeclaration of '" + pname + "' in the same scope");
+        else           declare((int)i, SymbolKind::Parameter, toValueType(at));
+    }
+}
+
+// Registered before its body, like CodeGen::generateMethod: visible to
+// itself and to later methods, and a duplicate keeps the first entry.
+void Checker::method(const FunctionAST* f, Atom className) {
+    Atom      mangledName = Atom::intern(className + "_" + f->proto->name);
+    Signature sig         = signatureOf(f->proto, true);
+    classes[className].methods.emplace(f->proto->name, sig);
+    functions.emplace(mangledName, sig);
+
+    inMethod   = true;
+    returnTy   = sig.ret;
+    terminated = false;
+    enterFunction(f, mangledName);
+    visit(f->body);
+    inMethod   = false;
+    terminated = false;
+}
+
+// ── Walk ──────────────────────────────────────────────────────
+
+void Checker::check(const ProgramAST& program) {
+    for (const AST* item : program.topLevel) visit(item);
+}
+
+Checker::Ty Checker::visit(const AST* node) {
+    if (!node) {
+        addError("[Checker] Internal: null AST node");
+        return Ty::None;
+    }
+
+    switch (node->kind) {
+    case ASTKind::LineComment:
+    case ASTKind::BlockComment:
+    case ASTKind::Prototype:
+        return Ty::None;
+
+    case ASTKind::Program:
+        check(*static_cast<const ProgramAST*>(node));
+        return Ty::None;
+
+    // ── Classes and objects ────────────────────────────────────
+    case ASTKind::ClassDecl: {
+        auto* cls = static_cast<const ClassDeclAST*>(node);
+        Class info;
+        for (const ClassField& f : cls->fields) {
+            if (f.type == ASTType::Void)
+                addError("Field '" + f.name + "' of class '" + cls->name + "' cannot be void");
+            info.fields.push_back({f.name, toValueType(f.type)});
+        }
+        classes[cls->name] = std::move(info);   // a redefinition replaces it
+
+        currentClass = cls->name;
+        for (const FunctionAST* m : cls->methods) method(m, cls->name);
+        currentClass = Atom();
+        return Ty::None;
+    }
+
+    case ASTKind::ObjectDecl: {
+        auto* od = static_cast<const ObjectDeclAST*>(node);
+        if (!classes.count(od->className)) {
+            addError("Unknown class '" + od->className + "'");
+            return Ty::None;
+        }
+        if (od->slot == kNoSlot) {
+            addError("Redeclaration of '" + od->varName + "' in same scope");
+            return Ty::None;
+        }
+        declare(od->slot, SymbolKind::Object, ValueType::Unknown, od->className);
+        return Ty::None;
+    }
+
+    case ASTKind::MemberAccess: {
+        auto* ma = static_cast<const MemberAccessAST*>(node);
+        const Local* sym = lookup(ma->objName, ma->slot);
+        if (!sym) { addError("Use of undeclared object '" + ma->objName + "'"); return Ty::None; }
+        if (sym->kind != SymbolKind::Object) {
+            addError("'" + ma->objName + "' is not an object"); return Ty::None;
+        }
+        auto it = classes.find(sym->objectClass);
+        if (it == classes.end()) { addError("Unknown class '" + sym->objectClass + "'"); return Ty::None; }
+        auto* field = it->second.field(ma->memberName);
+        if (!field) {
+            addError("'" + sym->objectClass + "' has no field '" + ma->memberName + "'");
+            return Ty::None;
+        }
+        return storedAs(field->second);
+    }
+
+    case ASTKind::MemberAssign: {
+        auto* ma = static_cast<const MemberAssignAST*>(node);
+        const Local* sym = lookup(ma->objName, ma->slot);
+        if (!sym) { addError("Assignment to undeclared object '" + ma->objName + "'"); return Ty::None; }
+        if (sym->kind != SymbolKind::Object) {
+            addError("'" + ma->objName + "' is not an object"); return Ty::None;
+        }
+        auto it = classes.find(sym->objectClass);
+        if (it == classes.end()) { addError("Unknown class '" + sym->objectClass + "'"); return Ty::None; }
+        auto* field = it->second.field(ma->memberName);
+        if (!field) {
+            addError("'" + sym->objectClass + "' has no field '" + ma->memberName + "'");
+            return Ty::None;
+        }
+        ValueType ft = field->second;
+        Ty val = visit(ma->expr);
+        if (val == Ty::None) return Ty::None;
+        return coerce(val, storedAs(ft));
+    }
+
+    case ASTKind::MethodCall: {
+        auto* mc = static_cast<const MethodCallAST*>(node);
+        Atom className;
+        if (mc->objName == thisAtom()) {
+            if (!inMethod) { addError("'this' method call outside of a method"); return Ty::None; }
+            className = currentClass;
+        } else {
+            const Local* sym = lookup(mc->objName, mc->slot);
+            if (!sym) { addError("Use of undeclared object '" + mc->objName + "'"); return Ty::None; }
+            if (sym->kind != SymbolKind::Object) {
+                addError("'" + mc->objName + "' is not an object"); return Ty::None;
+            }
+            className = sym->objectClass;
+        }
+
+        const Signature* sig = nullptr;
+        auto cls = classes.find(className);
+        if (cls != classes.end()) {
+            auto m = cls->second.methods.find(mc->methodName);
+            if (m != cls->second.methods.end()) sig = &m->second;
+        }
+        if (!sig) {
+            addError("Method '" + mc->methodName + "' not found in class '" + className + "'");
+            return Ty::None;
+        }
+        size_t expectedArgs = sig->params.size() - 1;   // exclude implicit this
+        if (expectedArgs != mc->args.size()) {
+            addError("Wrong argument count to '" + className + "::" + mc->methodName +
+                     "': expected " + std::to_string(expectedArgs) +
+                     ", got " + std::to_string(mc->args.size()));
+            return Ty::None;
+        }
+        for (size_t pi = 0; pi < mc->args.size(); ++pi) {
+            Ty v = visit(mc->args[pi]);
+            if (v == Ty::None) return Ty::None;
+            coerce(v, sig->params[pi + 1]);
+        }
+        return sig->ret;
+    }
+
+    case ASTKind::ThisAccess: {
+        auto* ta = static_cast<const ThisAccessAST*>(node);
+        if (!inMethod) { addError("'this' used outside of a method"); return Ty::None; }
+        auto* field = classes[currentClass].field(ta->memberName);
+        if (!field) {
+            addError("'" + currentClass + "' has no field '" + ta->memberName + "'");
+            return Ty::None;
+        }
+        return storedAs(field->second);
+    }
+
+    case ASTKind::ThisAssign: {
+        auto* ta = static_cast<const ThisAssignAST*>(node);
+        if (!inMethod) { addError("'this' assignment outside of a method"); return Ty::None; }
+        auto* field = classes[currentClass].field(ta->memberName);
+        if (!field) {
+            addError("'" + currentClass + "' has no field '" + ta->memberName + "'");
+            return Ty::None;
+        }
+        ValueType ft = field->second;
+        Ty val = visit(ta->expr);
+        if (val == Ty::None) return Ty::None;
+        return coerce(val, storedAs(ft));
+    }
+
+    // ── Scalars ────────────────────────────────────────────────
+    case ASTKind::Number: return Ty::Int;
+    case ASTKind::Float:  return Ty::Float;
+
+    case ASTKind::Variable: {
+        auto* v = static_cast<const VariableAST*>(node);
+        const Local* sym = lookup(v->name, v->slot);
+        if (!sym) { addError("Use of undeclared variable '" + v->name + "'"); return Ty::None; }
+        if (sym->kind == SymbolKind::Function) {
+            addError("'" + v->name + "' is a function, not a variable"); return Ty::None;
+        }
+        if (sym->kind == SymbolKind::Object) {
+            addError("Cannot use object '" + v->name + "' as a scalar value"); return Ty::None;
+        }
+        return storedAs(sym->type);   // an array reads as its element type, as in CodeGen
+    }
+
+    case ASTKind::VarDeclInit: {
+        auto* vi = static_cast<const VarDeclInitAST*>(node);
+        if (vi->slot == kNoSlot) {
+            addError("Redeclaration of '" + vi->name + "' in same scope"); return Ty::None;
+        }
+        if (vi->type == ASTType::Void) addError("Variable '" + vi->name + "' cannot be void");
+        declare(vi->slot, SymbolKind::Variable, toValueType(vi->type));
+        Ty init = visit(vi->init);
+        if (init == Ty::None) return Ty::None;
+        coerce(init, storedAs(toValueType(vi->type)));
+        return Ty::None;
+    }
+
+    case ASTKind::VarDecl: {
+        auto* vd = static_cast<const VarDeclAST*>(node);
+        if (vd->slot == kNoSlot) {
+            addError("Redeclaration of '" + vd->name + "' in same scope"); return Ty::None;
+        }
+        if (vd->type == ASTType::Void) addError("Variable '" + vd->name + "' cannot be void");
+        declare(vd->slot, SymbolKind::Variable, toValueType(vd->type));
+        return Ty::None;
+    }
+
+    case ASTKind::Assign: {
+        auto* a = static_cast<const AssignAST*>(node);
+        const Local* sym = lookup(a->name, a->slot);
+        if (!sym) { addError("Assignment to undeclared variable '" + a->name + "'"); return Ty::None; }
+        bool scalar = isScalar(sym->kind);
+        if (!scalar)
+            addError("Cannot assign to " + SymbolTable::kindName(sym->kind) + " '" + a->name + "'");
+        ValueType dst = sym->type;
+        Ty val = visit(a->expr);
+        if (val == Ty::None) return Ty::None;
+        return scalar ? coerce(val, storedAs(dst)) : val;
+    }
+
+    case ASTKind::PostInc: {
+        auto* inc = static_cast<const PostIncAST*>(node);
+        const Local* sym = lookup(inc->name, inc->slot);
+        if (!sym) { addError("Use of undeclared variable '" + inc->name + "' in '++'"); return Ty::None; }
+        if (!isScalar(sym->kind)) {
+            addError("Cannot increment " + SymbolTable::kindName(sym->kind) + " '" + inc->name + "'");
+            return Ty::None;
+        }
+        return storedAs(sym->type);
+    }
+
+    // ── Control flow ───────────────────────────────────────────
+    // 'terminated' tracks CodeGen's insert block: a block stops at the
+    // first statement that ends it, and the statements after it are
+    // never generated, so they are not checked either.
+    case ASTKind::If: {
+        auto* i = static_cast<const IfAST*>(node);
+        if (toBool(visit(i->cond)) == Ty::None) return Ty::None;
+        terminated = false;
+        visit(i->thenBlock);
+        terminated = false;
+        if (i->elseBlock) visit(i->elseBlock);
+        terminated = false;
+        return Ty::None;
+    }
+
+    case ASTKind::While: {
+        auto* w = static_cast<const WhileAST*>(node);
+        if (toBool(visit(w->cond)) == Ty::None) return Ty::None;   // body never generated
+        terminated = false;
+        ++loopDepth;
+        visit(w->body);
+        --loopDepth;
+        terminated = false;
+        return Ty::None;
+    }
+
+    case ASTKind::For: {
+        auto* f = static_cast<const ForAST*>(node);
+        if (f->init) visit(f->init);
+        if (f->cond) toBool(visit(f->cond));
+        terminated = false;
+        ++loopDepth;
+        visit(f->body);
+        --loopDepth;
+        terminated = false;
+        if (f->inc) visit(f->inc);
+        return Ty::None;
+    }
+
+    case ASTKind::Block: {
+        for (const AST* stmt : static_cast<const BlockAST*>(node)->statements) {
+            visit(stmt);
+            if (terminated) break;
+        }
+        return Ty::None;
+    }
+
+    case ASTKind::Return: {
+        auto* ret = static_cast<const ReturnAST*>(node);
+        if (ret->expr) {
+            Ty val = visit(ret->expr);
+            if (val == Ty::None) return Ty::None;
+            if (returnTy == Ty::Void)
+                addError("Void function '" + currentFunction + "' cannot return a value");
+            else
+                coerce(val, returnTy);
+        }
+        terminated = true;
+        return Ty::None;
+    }
+
+    case ASTKind::Break:
+        if (!loopDepth) { addError("'break' outside loop"); return Ty::None; }
+        terminated = true;
+        return Ty::None;
+
+    case ASTKind::Continue:
+        if (!loopDepth) { addError("'continue' outside loop"); return Ty::None; }
+        terminated = true;
+        return Ty::None;
+
+    // ── Functions ──────────────────────────────────────────────
+    case ASTKind::Function: {
+        auto* f = static_cast<const FunctionAST*>(node);
+        if (functions.count(f->proto->name)) {
+            addError("Redefinition of function '" + f->proto->name + "'"); return Ty::None;
+        }
+        Signature sig = signatureOf(f->proto, false);
+        returnTy = sig.ret;
+        functions.emplace(f->proto->name, std::move(sig));
+
+        terminated = false;
+        enterFunction(f, f->proto->name);
+        visit(f->body);
+        terminated = false;
+        return Ty::None;
+    }
+
+    case ASTKind::Call: {
+        auto* c = static_cast<const CallAST*>(node);
+        auto found = functions.find(c->callee);
+        if (found == functions.end()) {
+            addError("Call to undefined function '" + c->callee + "'"); return Ty::None;
+        }
+        const Signature& sig = found->second;
+        if (sig.params.size() != c->args.size()) {
+            addError("Wrong argument count to '" + c->callee + "': expected "
+                     + std::to_string(sig.params.size())
+                     + ", got " + std::to_string(c->args.size()));
+            return Ty::None;
+        }
+        size_t pi = 0;
+        for (const AST* a : c->args) {
+            Ty v = visit(a);
+            if (v == Ty::None) return Ty::None;
+            coerce(v, sig.params[pi++]);
+        }
+        return sig.ret;
+    }
+
+    // ── Arrays ─────────────────────────────────────────────────
+    case ASTKind::ArrayDecl: {
+        auto* a = static_cast<const ArrayDeclAST*>(node);
+        if (a->size <= 0) { addError("Array '" + a->name + "' has invalid size"); return Ty::None; }
+        if (a->slot == kNoSlot) {
+            addError("Redeclaration of array '" + a->name + "' in same scope"); return Ty::None;
+        }
+        if (a->type == ASTType::Void) addError("Array '" + a->name + "' cannot be void");
+        declare(a->slot, SymbolKind::Array, toValueType(a->type));
+        return Ty::None;
+    }
+
+    case ASTKind::ArrayAccess: {
+        auto* arr = static_cast<const ArrayAccessAST*>(node);
+        const Local* sym = lookup(arr->name, arr->slot);
+        if (!sym) { addError("Use of undeclared array '" + arr->name + "'"); return Ty::None; }
+        if (sym->kind != SymbolKind::Array) { addError("'" + arr->name + "' is not an array"); return Ty::None; }
+        ValueType elem = sym->type;
+        Ty idx = visit(arr->index);
+        if (idx == Ty::None) return Ty::None;
+        coerce(idx, Ty::Int);
+        return storedAs(elem);
+    }
+
+    case ASTKind::ArrayAssign: {
+        auto* aa = static_cast<const ArrayAssignAST*>(node);
+        const Local* sym = lookup(aa->name, aa->slot);
+        if (!sym) { addError("Assignment to undeclared array '" + aa->name + "'"); return Ty::None; }
+        if (sym->kind != SymbolKind::Array) { addError("'" + aa->name + "' is not an array"); return Ty::None; }
+        ValueType elem = sym->type;
+        Ty idx = visit(aa->index);
+        if (idx == Ty::None) return Ty::None;
+        coerce(idx, Ty::Int);
+        Ty val = visit(aa->expr);
+        if (val == Ty::None) return Ty::None;
+        return coerce(val, storedAs(elem));
+    }
+
+    // ── Operators ──────────────────────────────────────────────
+    case ASTKind::Binary:
+    case ASTKind::Logical:
+    case ASTKind::Unary:
+        return operators(node);
+    }
+
+    return Ty::None;
+}
+
+// Both operands of an arithmetic or comparison node are checked before
+// either result is looked at; '&&' and '||' skip their right operand
+// once the left one failed, as CodeGen does.
+Checker::Ty Checker::operators(const AST* root) {
+    const size_t frameBase = opFrames.size(), valueBase = opValues.size();
+    auto pop = [&] { Ty t = opValues.back(); opValues.pop_back(); return t; };
+    opFrames.push_back({root, 0});
+    while (opFrames.size() > frameBase) {
+        OpFrame f = opFrames.back();
+        opFrames.pop_back();
+        const AST* node = f.node;
+        if (!isOperatorNode(node)) {
+            opValues.push_back(visit(node));
+            continue;
+        }
+        auto* u   = ast_cast<UnaryAST>(node);
+        auto* bin = ast_cast<BinaryAST>(node);
+        auto* log = ast_cast<LogicalAST>(node);
+        bool shortCircuit = log && (log->op == BinOp::And || log->op == BinOp::Or);
+
+        if (f.stage == 0) {
+            opFrames.push_back({node, 1});
+            if (u) {
+                opFrames.push_back({u->operand, 0});
+            } else if (shortCircuit) {
+                opFrames.push_back({log->lhs, 0});
+            } else {
+                opFrames.push_back({bin ? bin->rhs : log->rhs, 0});
+                opFrames.push_back({bin ? bin->lhs : log->lhs, 0});
+            }
+            continue;
+        }
+
+        if (u) {
+            Ty operand = pop();
+            Ty result  = operand;
+            if (operand != Ty::None) {
+                if (u->op == UnOp::Neg) { coerce(operand, Ty::Int); result = Ty::Int; }
+                else                    result = toBool(operand);
+            }
+            opValues.push_back(result);
+            continue;
+        }
+        if (shortCircuit) {
+            if (toBool(pop()) == Ty::None) {
+                opValues.push_back(Ty::None);
+            } else if (f.stage == 1) {
+                opFrames.push_back({node, 2});
+                opFrames.push_back({log->rhs, 0});
+            } else {
+                opValues.push_back(Ty::Bool);
+            }
+            continue;
+        }
+
+        Ty r = pop();
+        Ty l = pop();
+        Ty result = Ty::None;
+        if (l == Ty::None || r == Ty::None) {
+            // reported where it failed
+        } else if (l == Ty::Void || r == Ty::Void) {
+            addError("Type mismatch: cannot coerce types");
+        } else if (log) {
+            if (log->op == BinOp::Eq || log->op == BinOp::Ne) result = Ty::Bool;
+            else addError(std::string("Unknown logical operator '") + opSpelling(log->op) + "'");
+        } else {
+            bool isFloat = l == Ty::Float || r == Ty::Float;
+            switch (bin->op) {
+            case BinOp::Add: case BinOp::Sub: case BinOp::Mul: case BinOp::Div:
+                result = isFloat ? Ty::Float : Ty::Int;
+                break;
+            case BinOp::Lt: case BinOp::Gt: case BinOp::Le: case BinOp::Ge:
+            case BinOp::Eq: case BinOp::Ne:
+                result = Ty::Bool;
+                break;
+            case BinOp::And:
+            case BinOp::Or:   // LogicalAST only
+                addError(std::string("Unknown binary operator '") + opSpelling(bin->op) + "'");
+                break;
+            }
+        }
+        opValues.push_back(result);
+    }
+    Ty t = opValues.back();
+    opValues.resize(valueBase);
+    return t;
+}
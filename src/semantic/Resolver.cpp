@@ -0,0 +1,315 @@
+#include "semantic/Resolver.h"
+
+static ValueType toValueType(ASTType t) {
+    switch (t) {
+        case ASTType::Float: return ValueType::Float;
+        case ASTType::Void:  return ValueType::Void;
+        default:             return ValueType::Int;
+    }
+}
+
+static bool isScalar(SymbolKind k) {
+    return k == SymbolKind::Variable || k == SymbolKind::Parameter;
+}
+
+// ── Scopes ────────────────────────────────────────────────────
+
+// CodeGen rejects a redeclaration in the same scope without declaring
+// anything, so neither do we.
+int Resolver::declare(Atom name, SymbolKind kind, ValueType type, int arraySize, Atom objectClass) {
+    if (symbols.isDeclaredInCurrentScope(name)) return kNoSlot;
+    int slot = nextSlot++;
+    symbols.insert(name, type, kind, arraySize, objectClass, slot);
+    return slot;
+}
+
+// ── Classes ───────────────────────────────────────────────────
+// First match wins, as in ClassInfo's field scan and method map.
+
+ValueType Resolver::fieldType(const ClassDeclAST* cls, Atom field) const {
+    if (cls)
+        for (const ClassField& f : cls->fields)
+            if (f.name == field) return toValueType(f.type);
+    return ValueType::Unknown;
+}
+
+ValueType Resolver::methodType(const ClassDeclAST* cls, Atom method) const {
+    if (cls)
+        for (const FunctionAST* m : cls->methods)
+            if (m->proto->name == method) return toValueType(m->proto->returnType);
+    return ValueType::Unknown;
+}
+
+// ── Walk ──────────────────────────────────────────────────────
+
+void Resolver::resolve(ProgramAST& program) {
+    for (AST* item : program.topLevel) visit(item);
+}
+
+// Parameters take slots 0..n-1 (a duplicate keeps its slot but binds
+// nothing); the body block opens the locals' scope.
+void Resolver::function(FunctionAST* f, Atom callName) {
+    const PrototypeAST* proto = f->proto;
+    std::vector<ValueType> paramTypes;
+    for (size_t i = 0; i < proto->args.size(); ++i)
+        paramTypes.push_back(toValueType(i < proto->argTypes.size() ? proto->argTypes[i] : ASTType::Int));
+    if (!symbols.lookupFunction(callName))   // a redefinition keeps the first
+        symbols.insertFunction(callName, toValueType(proto->returnType), paramTypes);
+
+    nextSlot = (int)proto->args.size();
+    symbols.enterScope();
+    symbols.setCurrentFunction(callName);
+    for (size_t i = 0; i < proto->args.size(); ++i)
+        if (!symbols.isDeclaredInCurrentScope(proto->args[i]))
+            symbols.insert(proto->args[i], paramTypes[i], SymbolKind::Parameter, 0, Atom(), (int)i);
+    if (f->body) visit(f->body);
+    symbols.clearCurrentFunction();
+    symbols.exitScope();
+    f->slotCount = nextSlot;
+}
+
+ValueType Resolver::visit(AST* node) {
+    if (!node) return ValueType::Unknown;
+    ValueType t = ValueType::Unknown;
+
+    switch (node->kind) {
+    case ASTKind::LineComment:
+    case ASTKind::BlockComment:
+    case ASTKind::Prototype:
+    case ASTKind::Break:
+    case ASTKind::Continue:
+        break;
+
+    case ASTKind::Program:
+        resolve(*static_cast<ProgramAST*>(node));
+        break;
+
+    case ASTKind::ClassDecl: {
+        auto* cls = static_cast<ClassDeclAST*>(node);
+        classes[cls->name] = cls;   // known to its own methods, like CodeGen's classTypes
+        currentClass = cls;
+        for (FunctionAST* m : cls->methods)
+            function(m, Atom::intern(cls->name + "_" + m->proto->name));
+        currentClass = nullptr;
+        break;
+    }
+
+    case ASTKind::Function: {
+        auto* f = static_cast<FunctionAST*>(node);
+        function(f, f->proto->name);
+        break;
+    }
+
+    // ── Declarations ───────────────────────────────────────────
+    case ASTKind::VarDecl: {
+        auto* vd = static_cast<VarDeclAST*>(node);
+        vd->slot = declare(vd->name, SymbolKind::Variable, toValueType(vd->type));
+        break;
+    }
+    case ASTKind::VarDeclInit: {
+        // Declared before the initializer is resolved, as in CodeGen.
+        auto* vi = static_cast<VarDeclInitAST*>(node);
+        vi->slot = declare(vi->name, SymbolKind::Variable, toValueType(vi->type));
+        visit(vi->init);
+        break;
+    }
+    case ASTKind::ArrayDecl: {
+        auto* a = static_cast<ArrayDeclAST*>(node);
+        if (a->size > 0)
+            a->slot = declare(a->name, SymbolKind::Array, toValueType(a->type), a->size);
+        break;
+    }
+    case ASTKind::ObjectDecl: {
+        auto* od = static_cast<ObjectDeclAST*>(node);
+        if (classes.count(od->className))
+            od->slot = declare(od->varName, SymbolKind::Object, ValueType::Unknown, 0, od->className);
+        break;
+    }
+
+    // ── Statements ─────────────────────────────────────────────
+    case ASTKind::Block: {
+        symbols.enterScope();
+        for (AST* stmt : static_cast<BlockAST*>(node)->statements) visit(stmt);
+        symbols.exitScope();
+        break;
+    }
+    case ASTKind::If: {
+        auto* i = static_cast<IfAST*>(node);
+        visit(i->cond); visit(i->thenBlock); visit(i->elseBlock);
+        break;
+    }
+    case ASTKind::While: {
+        auto* w = static_cast<WhileAST*>(node);
+        visit(w->cond); visit(w->body);
+        break;
+    }
+    case ASTKind::For: {
+        auto* f = static_cast<ForAST*>(node);
+        visit(f->init); visit(f->cond); visit(f->body); visit(f->inc);
+        break;
+    }
+    case ASTKind::Return:
+        visit(static_cast<ReturnAST*>(node)->expr);
+        break;
+
+    // ── Scalars ────────────────────────────────────────────────
+    case ASTKind::Number: t = ValueType::Int;   break;
+    case ASTKind::Float:  t = ValueType::Float; break;
+
+    case ASTKind::Variable: {
+        auto* v = static_cast<VariableAST*>(node);
+        const Symbol* b = symbols.lookup(v->name);
+        // A bare array name reads its first element.
+        if (b) v->slot = b->slot;
+        if (b && (isScalar(b->kind) || b->kind == SymbolKind::Array)) t = b->type;
+        break;
+    }
+    case ASTKind::Assign: {
+        auto* a = static_cast<AssignAST*>(node);
+        const Symbol* b = symbols.lookup(a->name);
+        if (b) a->slot = b->slot;
+        if (b && isScalar(b->kind)) t = b->type;
+        visit(a->expr);
+        break;
+    }
+    case ASTKind::PostInc: {
+        auto* inc = static_cast<PostIncAST*>(node);
+        const Symbol* b = symbols.lookup(inc->name);
+        if (b) inc->slot = b->slot;
+        if (b && isScalar(b->kind)) t = b->type;
+        break;
+    }
+
+    // ── Operators ──────────────────────────────────────────────
+    case ASTKind::Binary:
+    case ASTKind::Logical:
+    case ASTKind::Unary:
+        return operators(node);
+
+    case ASTKind::Call: {
+        auto* c = static_cast<CallAST*>(node);
+        for (AST* a : c->args) visit(a);
+        if (const Symbol* fn = symbols.lookupFunction(c->callee)) t = fn->returnType;
+        break;
+    }
+
+    // ── Arrays ─────────────────────────────────────────────────
+    case ASTKind::ArrayAccess: {
+        auto* arr = static_cast<ArrayAccessAST*>(node);
+        const Symbol* b = symbols.lookup(arr->name);
+        if (b) arr->slot = b->slot;
+        if (b && b->kind == SymbolKind::Array) t = b->type;
+        visit(arr->index);
+        break;
+    }
+    case ASTKind::ArrayAssign: {
+        auto* aa = static_cast<ArrayAssignAST*>(node);
+        const Symbol* b = symbols.lookup(aa->name);
+        if (b) aa->slot = b->slot;
+        if (b && b->kind == SymbolKind::Array) t = b->type;
+        visit(aa->index); visit(aa->expr);
+        break;
+    }
+
+    // ── Objects ────────────────────────────────────────────────
+    case ASTKind::MemberAccess: {
+        auto* ma = static_cast<MemberAccessAST*>(node);
+        const Symbol* b = symbols.lookup(ma->objName);
+        if (b) ma->slot = b->slot;
+        if (b && b->kind == SymbolKind::Object) {
+            auto it = classes.find(b->objectClass);
+            t = fieldType(it != classes.end() ? it->second : nullptr, ma->memberName);
+        }
+        break;
+    }
+    case ASTKind::MemberAssign: {
+        auto* ma = static_cast<MemberAssignAST*>(node);
+        const Symbol* b = symbols.lookup(ma->objName);
+        if (b) ma->slot = b->slot;
+        if (b && b->kind == SymbolKind::Object) {
+            auto it = classes.find(b->objectClass);
+            t = fieldType(it != classes.end() ? it->second : nullptr, ma->memberName);
+        }
+        visit(ma->expr);
+        break;
+    }
+    case ASTKind::MethodCall: {
+        auto* mc = static_cast<MethodCallAST*>(node);
+        const ClassDeclAST* cls = nullptr;
+        if (mc->objName == thisAtom()) {
+            cls = currentClass;
+        } else if (const Symbol* b = symbols.lookup(mc->objName)) {
+            mc->slot = b->slot;
+            auto it = classes.find(b->objectClass);
+            if (b->kind == SymbolKind::Object && it != classes.end()) cls = it->second;
+        }
+        t = methodType(cls, mc->methodName);
+        for (AST* a : mc->args) visit(a);
+        break;
+    }
+    case ASTKind::ThisAccess:
+        t = fieldType(currentClass, static_cast<ThisAccessAST*>(node)->memberName);
+        break;
+    case ASTKind::ThisAssign: {
+        auto* ta = static_cast<ThisAssignAST*>(node);
+        t = fieldType(currentClass, ta->memberName);
+        visit(ta->expr);
+        break;
+    }
+    }
+
+    node->valueType = t;
+    return t;
+}
+
+// Post-order over an operator tree: a node is expanded (its operands
+// pushed, lhs on top) and then combined once their types are on
+// opValues.  Operands that are not operators go through visit().
+ValueType Resolver::operators(AST* root) {
+    const size_t frameBase = opFrames.size(), valueBase = opValues.size();
+    opFrames.push_back({root, false});
+    while (opFrames.size() > frameBase) {
+        OpFrame f = opFrames.back();
+        opFrames.pop_back();
+        if (!isOperatorNode(f.node)) {
+            opValues.push_back(visit(f.node));
+            continue;
+        }
+        if (!f.expanded) {
+            opFrames.push_back({f.node, true});
+            if (auto* u = ast_cast<UnaryAST>(f.node)) {
+                opFrames.push_back({u->operand, false});
+            } else if (auto* bin = ast_cast<BinaryAST>(f.node)) {
+                opFrames.push_back({bin->rhs, false});
+                opFrames.push_back({bin->lhs, false});
+            } else {
+                auto* log = static_cast<LogicalAST*>(f.node);
+                opFrames.push_back({log->rhs, false});
+                opFrames.push_back({log->lhs, false});
+            }
+            continue;
+        }
+
+        // Comparisons, logical ops and '!' yield a truth value and '-'
+        // truncates to int; arithmetic follows its operands.
+        ValueType t = ValueType::Int;
+        if (f.node->kind == ASTKind::Unary) {
+            opValues.pop_back();
+        } else {
+            ValueType r = opValues.back(); opValues.pop_back();
+            ValueType l = opValues.back(); opValues.pop_back();
+            auto* bin = ast_cast<BinaryAST>(f.node);
+            if (bin && (bin->op == BinOp::Add || bin->op == BinOp::Sub ||
+                        bin->op == BinOp::Mul || bin->op == BinOp::Div)) {
+                if (l == ValueType::Float || r == ValueType::Float) t = ValueType::Float;
+                else if (l == ValueType::Int && r == ValueType::Int) t = ValueType::Int;
+                else t = ValueType::Unknown;
+            }
+        }
+        f.node->valueType = t;
+        opValues.push_back(t);
+    }
+    ValueType t = opValues.back();
+    opValues.resize(valueBase);
+    return t;
+}
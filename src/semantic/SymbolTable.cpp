@@ -2,18 +2,91 @@
 #include <stdexcept>
 
 SymbolTable::SymbolTable() {
+    slots.resize(64);
     enterScope(); // global scope
 }
 
-void SymbolTable::enterScope() { scopes.emplace_back(); }
+// ── Scopes ─────────────────────────────────────────────────────
+
+void SymbolTable::enterScope() { scopeMarks.push_back(locals.size()); }
 
 void SymbolTable::exitScope() {
-    if (scopes.size() <= 1)
+    if (scopeMarks.size() <= 1)
         throw std::runtime_error("[SymbolTable] Cannot exit global scope");
-    scopes.pop_back();
+    size_t mark = scopeMarks.back();
+    scopeMarks.pop_back();
+    while (locals.size() > mark) {
+        Binding& b = locals.back();
+        slot(b.sym.name).top = b.shadowed;
+        locals.pop_back();
+    }
+}
+
+// ── Hash table ─────────────────────────────────────────────────
+// Keyed by atom id.  Ids are dense and multiplying by an odd constant
+// permutes their low bits, so nearby names land in distinct slots.  Slots are
+// never freed: a name whose scopes have all closed keeps its slot with
+// a null binding, ready for the next declaration of that name.
+
+static size_t home(uint32_t key, size_t mask) {
+    return (size_t)(key * 2654435769u) & mask;
+}
+
+const SymbolTable::Slot* SymbolTable::findSlot(Atom name) const {
+    uint32_t key = name.id() + 1;
+    size_t mask = slots.size() - 1;
+    for (size_t i = home(key, mask);; i = (i + 1) & mask) {
+        if (slots[i].key == key) return &slots[i];
+        if (slots[i].key == 0)   return nullptr;
+    }
 }
 
+SymbolTable::Slot& SymbolTable::slot(Atom name) {
+    uint32_t key = name.id() + 1;
+    size_t mask = slots.size() - 1;
+    size_t i = home(key, mask);
+    for (; slots[i].key != 0; i = (i + 1) & mask)
+        if (slots[i].key == key) return slots[i];
+    if (2 * (used + 1) > slots.size()) {
+        grow();
+        return slot(name);
+    }
+    ++used;
+    slots[i].key = key;
+    return slots[i];
+}
+
+void SymbolTable::grow() {
+    std::vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (const Slot& s : old) {
+        if (s.key == 0) continue;
+        size_t i = home(s.key, mask);
+        while (slots[i].key != 0) i = (i + 1) & mask;
+        slots[i] = s;
+    }
+}
+
+// Locals go on top of the name's chain.  Globals go beneath any locals
+// of the same name (a function registered from inside a scope), so they
+// surface once those locals go out of scope.
+void SymbolTable::bind(Slot& s, const Symbol& sym) {
+    if (sym.definedAtDepth > 0) {
+        locals.push_back({sym, s.top});
+        s.top = &locals.back();
+        return;
+    }
+    Binding** link = &s.top;
+    while (*link && (*link)->sym.definedAtDepth > 0) link = &(*link)->shadowed;
+    globals.push_back({sym, *link});
+    *link = &globals.back();
+}
+
+// ── Insertion ──────────────────────────────────────────────────
+
 void SymbolTable::appendLog(const Symbol& sym) {
+    if (!logging) return;
     SymbolLogEntry e;
     e.name          = sym.name;
     e.kind          = sym.kind;
@@ -27,45 +100,39 @@ void SymbolTable::appendLog(const Symbol& sym) {
     log.push_back(e);
 }
 
-void SymbolTable::insert(const std::string& name,
+void SymbolTable::insert(Atom               name,
                          ValueType          type,
                          SymbolKind         kind,
-                         llvm::Value*       value,
                          int                arraySize,
-                         const std::string& objectClass)
+                         Atom               objectClass,
+                         int                localSlot)
 {
-    if (scopes.empty())
-        throw std::runtime_error("[SymbolTable] No active scope");
-
-    auto& top = scopes.back();
-    if (top.count(name))
+    Slot& s = slot(name);
+    if (s.top && s.top->sym.definedAtDepth == currentDepth())
         throw std::runtime_error("Redeclaration of '" + name + "' in the same scope");
 
     Symbol sym;
     sym.name           = name;
     sym.kind           = kind;
     sym.type           = type;
-    sym.value          = value;
     sym.arraySize      = arraySize;
     sym.definedAtDepth = currentDepth();
     sym.ownerFunction  = currentFunction;
     sym.objectClass    = objectClass;
-    top[name] = sym;
+    sym.slot           = localSlot;
+    bind(s, sym);
 
     appendLog(sym);
 }
 
-void SymbolTable::insertFunction(const std::string&            name,
+void SymbolTable::insertFunction(Atom                          name,
                                  ValueType                     returnType,
-                                 const std::vector<ValueType>& paramTypes,
-                                 llvm::Value*                  value)
+                                 const std::vector<ValueType>& paramTypes)
 {
-    if (scopes.empty())
-        throw std::runtime_error("[SymbolTable] No active scope");
-
-    auto& global = scopes.front();
-    if (global.count(name))
-        throw std::runtime_error("Redefinition of function '" + name + "'");
+    Slot& s = slot(name);
+    for (const Binding* b = s.top; b; b = b->shadowed)
+        if (b->sym.definedAtDepth == 0)
+            throw std::runtime_error("Redefinition of function '" + name + "'");
 
     Symbol sym;
     sym.name           = name;
@@ -73,51 +140,42 @@ void SymbolTable::insertFunction(const std::string&            name,
     sym.type           = returnType;
     sym.returnType     = returnType;
     sym.paramTypes     = paramTypes;
-    sym.value          = value;
     sym.definedAtDepth = 0;
-    sym.ownerFunction  = "";
-    global[name] = sym;
+    sym.ownerFunction  = Atom();
+    bind(s, sym);
 
     appendLog(sym);
 }
 
-Symbol* SymbolTable::lookup(const std::string& name) {
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        auto found = it->find(name);
-        if (found != it->end()) return &found->second;
-    }
-    return nullptr;
+// ── Lookup ─────────────────────────────────────────────────────
+
+Symbol* SymbolTable::lookup(Atom name) {
+    const Slot* s = findSlot(name);
+    return s && s->top ? &s->top->sym : nullptr;
 }
 
-const Symbol* SymbolTable::lookup(const std::string& name) const {
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        auto found = it->find(name);
-        if (found != it->end()) return &found->second;
-    }
-    return nullptr;
+const Symbol* SymbolTable::lookup(Atom name) const {
+    const Slot* s = findSlot(name);
+    return s && s->top ? &s->top->sym : nullptr;
 }
 
-const Symbol* SymbolTable::lookupCurrentScope(const std::string& name) const {
-    if (scopes.empty()) return nullptr;
-    auto found = scopes.back().find(name);
-    return found != scopes.back().end() ? &found->second : nullptr;
+const Symbol* SymbolTable::lookupCurrentScope(Atom name) const {
+    const Symbol* sym = lookup(name);
+    return sym && sym->definedAtDepth == currentDepth() ? sym : nullptr;
 }
 
-llvm::Value* SymbolTable::lookupValue(const std::string& name) const {
-    const Symbol* s = lookup(name);
-    return s ? s->value : nullptr;
+const Symbol* SymbolTable::lookupFunction(Atom name) const {
+    const Slot* s = findSlot(name);
+    for (const Binding* b = s ? s->top : nullptr; b; b = b->shadowed)
+        if (b->sym.definedAtDepth == 0 && b->sym.kind == SymbolKind::Function) return &b->sym;
+    return nullptr;
 }
 
-ValueType SymbolTable::lookupType(const std::string& name) const {
+ValueType SymbolTable::lookupType(Atom name) const {
     const Symbol* s = lookup(name);
     return s ? s->type : ValueType::Unknown;
 }
 
-void SymbolTable::updateValue(const std::string& name, llvm::Value* value) {
-    Symbol* s = lookup(name);
-    if (s) s->value = value;
-}
-
 std::string SymbolTable::typeName(ValueType t) {
     switch (t) {
         case ValueType::Int:     return "int";
@@ -0,0 +1,43 @@
+#include "utils/Atom.h"
+#include <ostream>
+
+const Atom::Entry Atom::kWellKnown[Atom::kWellKnownCount] = {
+    {"this", 1},
+    {"fast", 2},
+};
+
+Atom Atom::intern(std::string_view text) {
+    if (text.empty()) return {};
+    if (AtomTable* table = AtomTable::current()) return table->intern(text);
+    thread_local AtomTable own;
+    return own.intern(text);
+}
+
+AtomTable::AtomTable() {
+    for (const auto& e : Atom::kWellKnown) index.emplace(e.text, &e);
+}
+
+Atom AtomTable::intern(std::string_view text) {
+    if (text.empty()) return {};
+    auto it = index.find(text);
+    if (it != index.end()) return Atom(it->second);
+    entries.push_back({std::string(text), (uint32_t)(index.size() + 1)});
+    const Atom::Entry* e = &entries.back();
+    index.emplace(e->text, e);
+    return Atom(e);
+}
+
+AtomTable*& AtomTable::current() {
+    thread_local AtomTable* table = nullptr;
+    return table;
+}
+
+AtomTable::Scope::Scope(AtomTable& table) : prev(current()) { current() = &table; }
+
+void AtomTable::Scope::end() {
+    if (!active) return;
+    current() = prev;
+    active    = false;
+}
+
+std::ostream& operator<<(std::ostream& os, Atom a) { return os << a.str(); }
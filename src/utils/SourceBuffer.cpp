@@ -0,0 +1,76 @@
+#include "utils/SourceBuffer.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::SourceBuffer(const std::string& path) : filePath(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size = (size_t)st.st_size;
+        if (size == 0) { open = true; ::close(fd); return; }
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ::madvise(p, size, MADV_SEQUENTIAL);
+            data   = static_cast<const char*>(p);
+            mapped = true;
+            open   = true;
+            ::close(fd);
+            return;
+        }
+    }
+
+    // Not mappable (pipe, special file, mmap failure) — read it instead.
+    char chunk[1 << 16];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) owned.append(chunk, (size_t)n);
+    ::close(fd);
+    if (n < 0) return;
+    data = owned.data();
+    size = owned.size();
+    open = true;
+}
+
+SourceBuffer::SourceBuffer(std::string displayPath, std::string text)
+    : filePath(std::move(displayPath)), owned(std::move(text)), open(true)
+{
+    data = owned.data();
+    size = owned.size();
+}
+
+SourceBuffer::~SourceBuffer() {
+    if (mapped) ::munmap(const_cast<char*>(data), size);
+}
+
+// ── Line index ────────────────────────────────────────────────
+// Same line splitting as std::getline: a trailing '\n' does not start
+// a new (empty) line.
+void SourceBuffer::indexLines() const {
+    if (!lineStarts.empty() || size == 0) return;
+    lineStarts.push_back(0);
+    const char* p   = data;
+    const char* end = data + size;
+    while ((p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr) {
+        ++p;
+        if (p == end) break;
+        lineStarts.push_back((size_t)(p - data));
+    }
+}
+
+int SourceBuffer::lineCount() const {
+    indexLines();
+    return (int)lineStarts.size();
+}
+
+std::string_view SourceBuffer::lineText(int line) const {
+    indexLines();
+    if (line < 1 || line > (int)lineStarts.size()) return {};
+    size_t start = lineStarts[line - 1];
+    size_t end   = (line < (int)lineStarts.size()) ? lineStarts[line] - 1 : size;
+    if (end > start && data[end - 1] == '\n') --end;
+    return {data + start, end - start};
+}
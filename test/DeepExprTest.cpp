@@ -0,0 +1,130 @@
+// ============================================================
+//  Long and deeply nested expressions, end to end
+//
+//  Generates programs with operator chains of over 20k terms and
+//  with calls nested up to Parser::kMaxExprNesting, and compiles
+//  each with the real compiler (lex, parse, resolve, check, codegen).
+//  None may crash; the ones within the cap must compile cleanly and
+//  the one past it must fail with the parser's diagnostic.
+//
+//  Usage:  ./test_deep_expr <path to Quail_Compiler>
+// ============================================================
+
+#include "parser/Parser.h"
+#include <sys/wait.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+static std::string compiler;
+static fs::path    workDir;
+
+// ── Programs ──────────────────────────────────────────────────
+
+static std::string program(const std::string& body) {
+    return "int f(int a) {\n    return a;\n}\n\n"
+           "int main() {\n    int x;\n    x = 1;\n" + body + "    return 0;\n}\n";
+}
+
+// x = x + 1 * x - 2 + ... with 'terms' operands.
+static std::string arithmeticChain(int terms) {
+    const char* ops[] = {" + ", " * ", " - "};
+    std::string e = "x";
+    for (int i = 1; i < terms; ++i) e += ops[i % 3] + std::to_string(i % 7 + 1);
+    return program("    x = " + e + ";\n");
+}
+
+// if (x < 1 && x != 2 || ...) with 'terms' comparisons.
+static std::string logicalChain(int terms) {
+    std::string e = "x < 1";
+    for (int i = 1; i < terms; ++i)
+        e += (i % 5 ? " && x != " : " || x < ") + std::to_string(i);
+    return program("    if (" + e + ") {\n        x = 2;\n    }\n");
+}
+
+// x = f(x + 1 - f(x + 2 - ...)) nested 'depth' calls deep, each level a
+// short chain inside a parenthesised unary minus.
+static std::string nestedCalls(int depth, int termsPerLevel) {
+    std::string open, close;
+    for (int i = 0; i < depth; ++i) {
+        open += "f(";
+        for (int t = 1; t < termsPerLevel; ++t) open += "x + " + std::to_string(t) + " - ";
+        open += "-(";
+        close += "))";
+    }
+    return program("    x = " + open + "x" + close + ";\n");
+}
+
+// ── Running the compiler ──────────────────────────────────────
+
+struct Run {
+    bool        signaled = false;
+    int         status   = -1;
+    std::string output;
+};
+
+static Run compile(const std::string& name, const std::string& src, const std::string& flags) {
+    fs::path file = workDir / (name + ".mc");
+    std::ofstream(file) << src;
+    // exec, so a signal reaches pclose() rather than the shell's 128 + n.
+    std::string cmd = "exec \"" + compiler + "\" " + flags + " --no-autocorrect --out \"" +
+                      (workDir / name).string() + "\" \"" + file.string() + "\" 2>&1";
+    Run r;
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (!pipe) return r;
+    char buf[4096];
+    for (size_t n; (n = std::fread(buf, 1, sizeof buf, pipe)) > 0;) r.output.append(buf, n);
+    int status = pclose(pipe);
+    r.signaled = WIFSIGNALED(status);
+    r.status   = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return r;
+}
+
+// Compiles 'src' in every mode; 'error' empty expects success, otherwise
+// exit status 1 and that text in the output.
+static bool expect(const std::string& name, const std::string& src, const std::string& error = "") {
+    bool ok = true;
+    for (const char* flags : {"--check", "", "--release"}) {
+        Run r = compile(name, src, flags);
+        std::string what;
+        if (r.signaled)
+            what = "crashed";
+        else if (error.empty() && r.status != 0)
+            what = "exited " + std::to_string(r.status);
+        else if (!error.empty() && (r.status != 1 || r.output.find(error) == std::string::npos))
+            what = "exited " + std::to_string(r.status) + " without '" + error + "'";
+        if (!what.empty()) {
+            std::cerr << name << " [" << (*flags ? flags : "default") << "]: " << what << "\n";
+            ok = false;
+        }
+    }
+    std::cout << (ok ? "PASS  " : "FAIL  ") << name << "  (" << src.size() << " bytes)\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <path to Quail_Compiler>\n";
+        return 2;
+    }
+    compiler = argv[1];
+    workDir  = fs::temp_directory_path() / "quail_deep_expr";
+    fs::create_directories(workDir);
+
+    // The statement's own expression is one level; each call argument
+    // adds another.
+    const int maxCalls = Parser::kMaxExprNesting - 1;
+
+    bool ok = true;
+    ok &= expect("arithmetic chain", arithmeticChain(25000));
+    ok &= expect("logical chain",    logicalChain(25000));
+    ok &= expect("nested calls",     nestedCalls(maxCalls, 21));
+    ok &= expect("nested too deep",  nestedCalls(maxCalls + 1, 1), "Expression nested too deeply");
+
+    fs::remove_all(workDir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// ============================================================
+//  Serial vs parallel parse equivalence
+//
+//  Generates programs well above Parser::kMinParallelTokens
+//  (bench/ProgramGen.h), some with syntax errors spliced in, and
+//  parses each with one thread and with several.  The AST dumps and
+//  the error lists (line and message) must be identical.
+//
+//  Usage:  ./test_parallel_parse        (exit status 0 on success)
+// ============================================================
+
+#include "ProgramGen.h"
+#include "lexer/Lexer.h"
+#include "lexer/TokenStream.h"
+#include "parser/Parser.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct ParseResult {
+    std::string             dump;
+    std::vector<ParseError> errors;
+};
+
+static ParseResult parse(const TokenStream& tokens, unsigned threads) {
+    Parser parser(tokens, threads);
+    auto ast = parser.parse();
+    ParseResult r;
+    std::ostringstream dump;
+    auto* saved = std::cout.rdbuf(dump.rdbuf());   // AST::print writes to std::cout
+    if (ast) ast->print(0);
+    std::cout.rdbuf(saved);
+    r.dump   = dump.str();
+    r.errors = parser.getErrors();
+    return r;
+}
+
+// Every 'every'-th occurrence of 'from' in 'src' becomes 'to'.
+static std::string corrupt(const std::string& src, const std::string& from, const std::string& to, int every) {
+    std::string out;
+    size_t prev = 0;
+    int n = 0;
+    for (size_t at = src.find(from); at != std::string::npos; at = src.find(from, prev)) {
+        out.append(src, prev, at - prev);
+        out += ++n % every == 0 ? to : from;
+        prev = at + from.size();
+    }
+    return out.append(src, prev, std::string::npos);
+}
+
+static bool same(const std::string& name, const std::string& src) {
+    AtomTable        atoms;
+    AtomTable::Scope interning(atoms);
+    Lexer lexer(src, true);
+    TokenStream tokens(lexer);
+    if (tokens.size() < Parser::kMinParallelTokens) {
+        std::cerr << name << ": only " << tokens.size() << " tokens, below the parallel threshold\n";
+        return false;
+    }
+
+    ParseResult serial   = parse(tokens, 1);
+    ParseResult parallel = parse(tokens, 4);
+    bool ok = true;
+    if (serial.dump != parallel.dump) {
+        std::cerr << name << ": AST dumps differ\n";
+        ok = false;
+    }
+    if (serial.errors.size() != parallel.errors.size()) {
+        std::cerr << name << ": " << serial.errors.size() << " errors serially, "
+                  << parallel.errors.size() << " in parallel\n";
+        ok = false;
+    }
+    for (size_t i = 0; ok && i < serial.errors.size(); ++i)
+        if (serial.errors[i].line != parallel.errors[i].line ||
+            serial.errors[i].message != parallel.errors[i].message) {
+            std::cerr << name << ": error " << i << " differs: line " << serial.errors[i].line
+                      << " '" << serial.errors[i].message << "' vs line " << parallel.errors[i].line
+                      << " '" << parallel.errors[i].message << "'\n";
+            ok = false;
+        }
+    std::cout << (ok ? "PASS  " : "FAIL  ") << name << "  (" << tokens.size() << " tokens, "
+              << serial.errors.size() << " errors)\n";
+    return ok;
+}
+
+int main() {
+    GenOptions opt;
+    opt.functions = 120;
+    opt.classes   = 12;
+    std::string clean = ProgramGen(opt).generate();
+
+    bool ok = true;
+    ok &= same("clean", clean);
+    ok &= same("missing ';'",   corrupt(clean, ";\n", "\n", 41));
+    ok &= same("stray ')'",     corrupt(clean, " = ", " = ) ", 53));
+    ok &= same("missing '}'",   corrupt(clean, "}\n", "\n", 29));
+    return ok ? 0 : 1;
+}